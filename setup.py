@@ -516,6 +516,7 @@ def define_DSOS(self):
         'util.cpp',
         'osgroups.cpp',
         'sharedarray.cpp',
+        'arrayops.cpp',
         'bitmask.cpp',
         'type.cpp',
         'data.cpp',
@@ -0,0 +1,354 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "arrayops.h"
+
+// SSE2 is part of the x86_64 baseline, and optional for 32-bit x86
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#  define USE_SSE2
+#  include <emmintrin.h>
+#endif
+
+// AVX2 is selected at runtime, which requires GCC or clang function attributes
+#if defined(USE_SSE2) && defined(__GNUC__) && (defined(__clang__) || __GNUC__>=5)
+#  define USE_AVX2
+#  include <immintrin.h>
+#  define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// NEON is part of the aarch64 baseline
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#  define USE_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace pvxs {namespace impl {
+
+namespace {
+
+/* Scalar fallback.  Also used for the remainder of vectorized loops.
+ * Compilers recognize these shift patterns as byte swap instructions.
+ */
+
+inline uint16_t bswap(uint16_t v) { return uint16_t((v<<8u) | (v>>8u)); }
+inline uint32_t bswap(uint32_t v) {
+    return (v<<24u) | ((v<<8u)&0x00ff0000u) | ((v>>8u)&0x0000ff00u) | (v>>24u);
+}
+inline uint64_t bswap(uint64_t v) {
+    return (uint64_t(bswap(uint32_t(v)))<<32u) | bswap(uint32_t(v>>32u));
+}
+
+template<typename T>
+void swapScalar(void* dest, const void* src, size_t count)
+{
+    auto D = static_cast<uint8_t*>(dest);
+    auto S = static_cast<const uint8_t*>(src);
+    for(size_t i=0u; i<count; i++) {
+        T v;
+        memcpy(&v, S + i*sizeof(T), sizeof(T));
+        v = bswap(v);
+        memcpy(D + i*sizeof(T), &v, sizeof(T));
+    }
+}
+
+template<typename Dest, typename Src>
+void convertScalar(Dest* dest, const Src* src, size_t count)
+{
+    for(size_t i=0u; i<count; i++)
+        dest[i] = Dest(src[i]);
+}
+
+#ifdef USE_SSE2
+
+inline __m128i sse2Swap16(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+template<size_t N> __m128i sse2Swap(__m128i v);
+template<> inline __m128i sse2Swap<2>(__m128i v) { return sse2Swap16(v); }
+template<> inline __m128i sse2Swap<4>(__m128i v) {
+    // swap bytes of each 16-bit word, then swap the words of each 32-bit element
+    v = sse2Swap16(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+template<> inline __m128i sse2Swap<8>(__m128i v) {
+    v = sse2Swap16(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+template<typename T>
+void swapSSE2(void* dest, const void* src, size_t count)
+{
+    constexpr size_t step = 16u/sizeof(T);
+    auto D = static_cast<uint8_t*>(dest);
+    auto S = static_cast<const uint8_t*>(src);
+    size_t i=0u;
+    for(; i+step<=count; i+=step) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i*sizeof(T)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(D + i*sizeof(T)), sse2Swap<sizeof(T)>(v));
+    }
+    swapScalar<T>(D + i*sizeof(T), S + i*sizeof(T), count-i);
+}
+
+void convertSSE2(double* dest, const int32_t* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        _mm_storeu_pd(dest+i, _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src+i))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertSSE2(int32_t* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest+i), _mm_cvttpd_epi32(_mm_loadu_pd(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertSSE2(double* dest, const float* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        _mm_storeu_pd(dest+i, _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src+i)))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertSSE2(float* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest+i), _mm_castps_si128(_mm_cvtpd_ps(_mm_loadu_pd(src+i))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+#endif // USE_SSE2
+
+#ifdef USE_AVX2
+
+template<typename T>
+TARGET_AVX2
+void swapAVX2(void* dest, const void* src, size_t count)
+{
+    // byte shuffle, within each 128-bit lane
+    uint8_t order[32];
+    for(size_t i=0u; i<sizeof(order); i++) {
+        size_t lane = i%16u;
+        order[i] = uint8_t((lane/sizeof(T))*sizeof(T) + sizeof(T)-1u - lane%sizeof(T));
+    }
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(order));
+
+    constexpr size_t step = 32u/sizeof(T);
+    auto D = static_cast<uint8_t*>(dest);
+    auto S = static_cast<const uint8_t*>(src);
+    size_t i=0u;
+    for(; i+step<=count; i+=step) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i*sizeof(T)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i*sizeof(T)), _mm256_shuffle_epi8(v, mask));
+    }
+    swapScalar<T>(D + i*sizeof(T), S + i*sizeof(T), count-i);
+}
+
+TARGET_AVX2
+void convertAVX2(double* dest, const int32_t* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+4u<=count; i+=4u)
+        _mm256_storeu_pd(dest+i, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+TARGET_AVX2
+void convertAVX2(int32_t* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+4u<=count; i+=4u)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest+i), _mm256_cvttpd_epi32(_mm256_loadu_pd(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+TARGET_AVX2
+void convertAVX2(double* dest, const float* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+4u<=count; i+=4u)
+        _mm256_storeu_pd(dest+i, _mm256_cvtps_pd(_mm_loadu_ps(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+TARGET_AVX2
+void convertAVX2(float* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+4u<=count; i+=4u)
+        _mm_storeu_ps(dest+i, _mm256_cvtpd_ps(_mm256_loadu_pd(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+#endif // USE_AVX2
+
+#ifdef USE_NEON
+
+template<size_t N> uint8x16_t neonSwap(uint8x16_t v);
+template<> inline uint8x16_t neonSwap<2>(uint8x16_t v) { return vrev16q_u8(v); }
+template<> inline uint8x16_t neonSwap<4>(uint8x16_t v) { return vrev32q_u8(v); }
+template<> inline uint8x16_t neonSwap<8>(uint8x16_t v) { return vrev64q_u8(v); }
+
+template<typename T>
+void swapNEON(void* dest, const void* src, size_t count)
+{
+    constexpr size_t step = 16u/sizeof(T);
+    auto D = static_cast<uint8_t*>(dest);
+    auto S = static_cast<const uint8_t*>(src);
+    size_t i=0u;
+    for(; i+step<=count; i+=step)
+        vst1q_u8(D + i*sizeof(T), neonSwap<sizeof(T)>(vld1q_u8(S + i*sizeof(T))));
+    swapScalar<T>(D + i*sizeof(T), S + i*sizeof(T), count-i);
+}
+
+void convertNEON(double* dest, const int32_t* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        vst1q_f64(dest+i, vcvtq_f64_s64(vmovl_s32(vld1_s32(src+i))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertNEON(int32_t* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        vst1_s32(dest+i, vmovn_s64(vcvtq_s64_f64(vld1q_f64(src+i))));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertNEON(double* dest, const float* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        vst1q_f64(dest+i, vcvt_f64_f32(vld1_f32(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+void convertNEON(float* dest, const double* src, size_t count)
+{
+    size_t i=0u;
+    for(; i+2u<=count; i+=2u)
+        vst1_f32(dest+i, vcvt_f32_f64(vld1q_f64(src+i)));
+    convertScalar(dest+i, src+i, count-i);
+}
+
+#endif // USE_NEON
+
+struct Kernels {
+    const char* name;
+    void (*swap16)(void*, const void*, size_t);
+    void (*swap32)(void*, const void*, size_t);
+    void (*swap64)(void*, const void*, size_t);
+    void (*i32tof64)(double*, const int32_t*, size_t);
+    void (*f64toi32)(int32_t*, const double*, size_t);
+    void (*f32tof64)(double*, const float*, size_t);
+    void (*f64tof32)(float*, const double*, size_t);
+};
+
+// usable on this host, preferred first.
+std::vector<Kernels> availableKernels()
+{
+    std::vector<Kernels> ret;
+#ifdef USE_AVX2
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        ret.push_back(Kernels{"AVX2",
+                              &swapAVX2<uint16_t>, &swapAVX2<uint32_t>, &swapAVX2<uint64_t>,
+                              &convertAVX2, &convertAVX2, &convertAVX2, &convertAVX2});
+#endif
+#ifdef USE_SSE2
+    ret.push_back(Kernels{"SSE2",
+                          &swapSSE2<uint16_t>, &swapSSE2<uint32_t>, &swapSSE2<uint64_t>,
+                          &convertSSE2, &convertSSE2, &convertSSE2, &convertSSE2});
+#endif
+#ifdef USE_NEON
+    ret.push_back(Kernels{"NEON",
+                          &swapNEON<uint16_t>, &swapNEON<uint32_t>, &swapNEON<uint64_t>,
+                          &convertNEON, &convertNEON, &convertNEON, &convertNEON});
+#endif
+    ret.push_back(Kernels{"scalar",
+                          &swapScalar<uint16_t>, &swapScalar<uint32_t>, &swapScalar<uint64_t>,
+                          &convertScalar<double, int32_t>, &convertScalar<int32_t, double>,
+                          &convertScalar<double, float>, &convertScalar<float, double>});
+    return ret;
+}
+
+const std::vector<Kernels>& allKernels()
+{
+    static const std::vector<Kernels> all(availableKernels());
+    return all;
+}
+
+// cf. arrayOpsForce()
+std::atomic<const Kernels*> forced{nullptr};
+
+const Kernels& kernels()
+{
+    static const Kernels& preferred = allKernels().front();
+    auto impl = forced.load(std::memory_order_relaxed);
+    return impl ? *impl : preferred;
+}
+
+} // namespace
+
+void swapCopy(void* dest, const void* src, size_t count, size_t esize)
+{
+    switch(esize) {
+    case 1u: memcpy(dest, src, count); break;
+    case 2u: kernels().swap16(dest, src, count); break;
+    case 4u: kernels().swap32(dest, src, count); break;
+    case 8u: kernels().swap64(dest, src, count); break;
+    default: {
+        // not used for PVA types
+        auto D = static_cast<uint8_t*>(dest);
+        auto S = static_cast<const uint8_t*>(src);
+        for(size_t i=0u; i<count*esize; i+=esize) {
+            for(size_t n=0u; n<esize; n++)
+                D[i + esize-1u-n] = S[i + n];
+        }
+    }
+    }
+}
+
+void convertArray(double* dest, const int32_t* src, size_t count) { kernels().i32tof64(dest, src, count); }
+void convertArray(int32_t* dest, const double* src, size_t count) { kernels().f64toi32(dest, src, count); }
+void convertArray(double* dest, const float* src, size_t count) { kernels().f32tof64(dest, src, count); }
+void convertArray(float* dest, const double* src, size_t count) { kernels().f64tof32(dest, src, count); }
+
+const char* arrayOpsImpl()
+{
+    return kernels().name;
+}
+
+bool arrayOpsForce(const char* name)
+{
+    if(!name) {
+        forced.store(nullptr);
+        return true;
+    }
+    for(auto& impl : allKernels()) {
+        if(strcmp(impl.name, name)==0) {
+            forced.store(&impl);
+            return true;
+        }
+    }
+    return false;
+}
+
+}} // namespace pvxs::impl
@@ -0,0 +1,49 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+#ifndef ARRAYOPS_H
+#define ARRAYOPS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <pvxs/version.h>
+
+namespace pvxs {namespace impl {
+
+/* Bulk array kernels, vectorized where supported.
+ * Implementation (eg. SSE2, AVX2, NEON, or scalar) is selected at runtime.
+ *
+ * Pointers need not be aligned.  Source and destination must not overlap.
+ */
+
+//! Copy count elements of esize bytes (1, 2, 4, or 8), reversing the byte order of each.
+PVXS_API
+void swapCopy(void* dest, const void* src, size_t count, size_t esize);
+
+PVXS_API
+void convertArray(double* dest, const int32_t* src, size_t count);
+//! Truncates, as with a C++ cast.  Out of range elements give an implementation defined result.
+PVXS_API
+void convertArray(int32_t* dest, const double* src, size_t count);
+PVXS_API
+void convertArray(double* dest, const float* src, size_t count);
+PVXS_API
+void convertArray(float* dest, const double* src, size_t count);
+
+//! Name of the selected implementation.  eg. "AVX2"
+PVXS_API
+const char* arrayOpsImpl();
+
+/** For testing.  Use the named implementation (eg. "scalar") instead of the one selected,
+ *  or restore the selected implementation if name is nullptr.
+ *  @returns false if the named implementation is not available on this host.
+ */
+PVXS_API
+bool arrayOpsForce(const char* name);
+
+}} // namespace pvxs::impl
+
+#endif // ARRAYOPS_H
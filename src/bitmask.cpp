@@ -14,16 +14,31 @@ namespace pvxs {
 
 
 BitMask::BitMask(BitMask&& o) noexcept
-    :_words(std::move(o._words))
-    ,_size(o._size)
 {
-    o._size = 0u;
+    *this = std::move(o);
 }
 
 BitMask& BitMask::operator=(BitMask&& o) noexcept
 {
-    _words = std::move(o._words);
+    if(this==&o)
+        return *this;
+
+    if(_words!=_inline)
+        delete[] _words;
+
+    if(o._words!=o._inline) {
+        // steal allocation
+        _words = o._words;
+        _wcap = o._wcap;
+    } else {
+        _words = _inline;
+        _wcap = inline_words;
+        std::copy(o._inline, o._inline+inline_words, _inline);
+    }
     _size = o._size;
+
+    o._words = o._inline;
+    o._wcap = inline_words;
     o._size = 0u;
     return *this;
 }
@@ -42,49 +57,39 @@ BitMask::BitMask(std::initializer_list<size_t> bits, size_t nbits)
 }
 
 void BitMask::resize(size_t bits) {
-    // round up to multiple of 64
-    size_t storebits = ((bits-1u)|0x3f)+1u;
-    _words.resize(storebits/64u, 0u);
+    const size_t oldw = wsize();
+    const size_t neww = (bits+63u)/64u;
+
+    if(neww > _wcap) {
+        auto words = new uint64_t[neww];
+        std::copy(_words, _words+oldw, words);
+        if(_words!=_inline)
+            delete[] _words;
+        _words = words;
+        _wcap = uint16_t(neww);
+    }
+    // zero any newly added words
+    if(neww > oldw)
+        std::fill(_words+oldw, _words+neww, 0u);
     _size = uint16_t(bits);
 }
 
 size_t BitMask::findSet(size_t start) const
 {
-    while(start < _size) {
-        size_t word = start/64u,
-                bit = start%64u;
-
-        // first see if we can skip to next word
-        uint64_t mask = ~((1ull<<bit)-1); // mask of bit and higher
-        uint64_t masked = _words[word]&mask;
-        if(masked==0u) {
-            start = (word+1u)*64u;
-            continue;
-        }
-
-        // the answer is in range [bit, 64)
-
-        // count consecutive "trailing" zeros.
-        // http://graphics.stanford.edu/~seander/bithacks.html#ZerosOnRightParallel
-
-        masked &= -masked; // and with two's complement.  neat.  clears all except the bit we care about
+    if(start >= _size)
+        return _size;
 
-        // now a binary search
-        // we know masked is non-zero, and can start from 63
-        //bit = 64u;
-        //if(masked) bit--;
-        bit = 63u;
-        if(masked&0x00000000ffffffffull) bit -= 32u;
-        if(masked&0x0000ffff0000ffffull) bit -= 16u;
-        if(masked&0x00ff00ff00ff00ffull) bit -= 8u;
-        if(masked&0x0f0f0f0f0f0f0f0full) bit -= 4u;
-        if(masked&0x3333333333333333ull) bit -= 2u; // 0xb0011 repeated
-        if(masked&0x5555555555555555ull) bit -= 1u; // 0xb0101 repeated
+    size_t word = start/64u;
+    // mask of bit and higher
+    uint64_t masked = _words[word] & ((~uint64_t(0)) << (start%64u));
 
-        return (word*64u) | bit;
+    for(const size_t nwords = wsize(); !masked;) {
+        if(++word >= nwords)
+            return _size;
+        masked = _words[word];
     }
 
-    return _size;
+    return std::min(size_t(_size), word*64u + detail::ctz64(masked));
 }
 
 std::ostream& operator<<(std::ostream& strm, const BitMask& mask)
@@ -105,9 +110,9 @@ bool operator==(const BitMask& lhs, const BitMask& rhs)
     if(lhs.size()!=rhs.size())
         return false;
 
-    return std::equal(lhs._words.begin(),
-                      lhs._words.end(),
-                      rhs._words.begin());
+    return std::equal(lhs._words,
+                      lhs._words + lhs.wsize(),
+                      rhs._words);
 }
 
 namespace impl {
@@ -14,9 +14,36 @@
 
 #include <pvxs/version.h>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#  include <intrin.h>
+#endif
+
 namespace pvxs {
 
 namespace detail {
+
+//! Count trailing zero bits.  Result undefined for zero.
+inline unsigned ctz64(uint64_t v)
+{
+#if defined(__GNUC__)
+    return unsigned(__builtin_ctzll(v));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long ret;
+    _BitScanForward64(&ret, v);
+    return unsigned(ret);
+#else
+    // http://graphics.stanford.edu/~seander/bithacks.html#ZerosOnRightParallel
+    v &= -v; // and with two's complement.  clears all except the lowest set bit
+    unsigned bit = 63u;
+    if(v&0x00000000ffffffffull) bit -= 32u;
+    if(v&0x0000ffff0000ffffull) bit -= 16u;
+    if(v&0x00ff00ff00ff00ffull) bit -= 8u;
+    if(v&0x0f0f0f0f0f0f0f0full) bit -= 4u;
+    if(v&0x3333333333333333ull) bit -= 2u; // 0xb0011 repeated
+    if(v&0x5555555555555555ull) bit -= 1u; // 0xb0101 repeated
+    return bit;
+#endif
+}
 // base type, defines operations which can be performed on an BitMask expression
 template <typename Sub>
 struct BitBase {
@@ -89,13 +116,20 @@ operator |(const BitBase<Lhs>& lhs, const BitBase<Rhs>& rhs)
 } // namespace detail
 
 class BitMask : public detail::BitBase<BitMask> {
+    // masks of up to 128 bits (the common case) are stored inline
+    static constexpr size_t inline_words = 2u;
+
     // bit  0 - lsb of word 0
     // bit 63 - msb of word 0
     // bit 64 - lsb of word 1
-    std::vector<uint64_t> _words;
+    // either _inline or heap allocated
+    uint64_t* _words = _inline;
+    uint64_t _inline[inline_words];
     // actual size in bits
-    // _words.size()*64u >= _size
+    // wsize()*64u >= _size
     uint16_t _size=0u;
+    // allocated size of _words
+    uint16_t _wcap=inline_words;
 
 public:
 
@@ -108,7 +142,10 @@ public:
     BitMask(BitMask&&) noexcept;
     BitMask& operator=(const BitMask&) = delete;
     BitMask& operator=(BitMask&&) noexcept;
-    ~BitMask() = default;
+    ~BitMask() {
+        if(_words!=_inline)
+            delete[] _words;
+    }
 
     //! cleared mask with size()==0
     explicit BitMask(size_t nbits) {
@@ -124,7 +161,7 @@ public:
     inline bool empty() const { return _size==0u; }
 
     //! number of storage words
-    inline size_t wsize() const { return _words.size(); }
+    inline size_t wsize() const { return (size_t(_size)+63u)/64u; }
     //! storage word
     inline uint64_t& word(size_t i) { return _words[i]; }
     inline const uint64_t& word(size_t i) const { return _words[i]; }
@@ -171,13 +208,41 @@ private:
         friend BitMask;
         const BitMask* _mask = nullptr;
         size_t _bit = 0u;
+        size_t _end = 0u;
+        // remaining set bits of the word containing _bit, excluding _bit
+        uint64_t _rest = 0u;
+
+        void _settle() {
+            if(_bit>=_end) {
+                _bit = _end;
+                _rest = 0u;
+            } else {
+                _rest = _mask->_words[_bit/64u] & ((~uint64_t(1)) << (_bit%64u));
+            }
+        }
+        void _next() {
+            if(_rest) {
+                // next bit in same word
+                _bit = (_bit & ~size_t(63u)) | detail::ctz64(_rest);
+                _rest &= _rest-1u;
+                if(_bit>=_end) {
+                    _bit = _end;
+                    _rest = 0u;
+                }
+            } else {
+                _bit = std::min(_end, _mask->findSet((_bit|63u)+1u));
+                _settle();
+            }
+        }
     public:
         constexpr _SetIter() = default;
-        constexpr _SetIter(const BitMask* mask, size_t bit) :_mask(mask), _bit(bit) {}
+        _SetIter(const BitMask* mask, size_t bit, size_t end)
+            :_mask(mask), _bit(bit), _end(std::min(end, mask->size()))
+        { _settle(); }
 
         size_t operator*() const { return _bit; }
-        _SetIter& operator++() { _bit=_mask->findSet(_bit+1); return *this; }
-        _SetIter operator++(int) { _SetIter ret{*this}; _bit=_mask->findSet(_bit+1); return ret;}
+        _SetIter& operator++() { _next(); return *this; }
+        _SetIter operator++(int) { _SetIter ret{*this}; _next(); return ret;}
 
         bool operator==(const _SetIter& o) { return _bit==o._bit; }
         bool operator!=(const _SetIter& o) { return _bit!=o._bit; }
@@ -189,8 +254,8 @@ private:
         constexpr explicit _OnlySet(const BitMask* mask, size_t a, size_t b) :_mask(mask), a(a), b(b) {}
     public:
         typedef _SetIter iterator;
-        iterator begin() const { return iterator{_mask, _mask->findSet(a)}; }
-        iterator end() const { return iterator{_mask, b}; }
+        iterator begin() const { return iterator{_mask, std::min(b, _mask->findSet(a)), b}; }
+        iterator end() const { return iterator{_mask, b, b}; }
     };
 
 public:
@@ -176,7 +176,7 @@ void Channel::disconnect(const std::shared_ptr<Channel>& self)
     } else { // reconnect to specific server
         // TODO: holdoff to prevent fast reconnect loop
 
-        conn = Connection::build(context, forcedServer);
+        conn = Connection::build(context, forcedServer, prio);
 
         conn->pending[cid] = self;
         state = Connecting;
@@ -303,10 +303,13 @@ RequestInfo::RequestInfo(uint32_t sid, uint32_t ioid, std::shared_ptr<OperationB
 
 std::shared_ptr<Channel> Channel::build(const std::shared_ptr<ContextImpl>& context,
                                         const std::string& name,
-                                        const std::string& server)
+                                        const std::string& server,
+                                        unsigned prio)
 {
+    prio = std::min(prio, pva_max_priority);
+
     SockAddr forceServer;
-    decltype (context->chanByName)::key_type namekey(name, server);
+    decltype (context->chanByName)::key_type namekey(name, server, prio);
 
     if(!server.empty()) {
         forceServer.setAddress(server.c_str(), context->effective.tcp_port);
@@ -325,6 +328,7 @@ std::shared_ptr<Channel> Channel::build(const std::shared_ptr<ContextImpl>& cont
             context->nextCID++;
 
         chan = std::make_shared<Channel>(context, name, context->nextCID);
+        chan->prio = prio;
 
         context->chanByCID[chan->cid] = chan;
         context->chanByName[namekey] = chan;
@@ -336,7 +340,7 @@ std::shared_ptr<Channel> Channel::build(const std::shared_ptr<ContextImpl>& cont
 
         } else { // bypass search and connect so a specific server
             chan->forcedServer = forceServer;
-            chan->conn = Connection::build(context, forceServer);
+            chan->conn = Connection::build(context, forceServer, prio);
 
             chan->conn->pending[chan->cid] = chan;
             chan->state = Connecting;
@@ -423,6 +427,7 @@ Report Context::report(bool zero) const
             sconn.peer = conn->peerName;
             sconn.tx = conn->statTx;
             sconn.rx = conn->statRx;
+            sconn.priority = conn->priority;
 
             if(zero) {
                 conn->statTx = conn->statRx = 0u;
@@ -729,7 +734,7 @@ void procSearchReply(ContextImpl& self, const SockAddr& src, Buffer& M, bool ist
             chan->guid = guid;
             chan->replyAddr = serv;
 
-            chan->conn = Connection::build(self.shared_from_this(), serv);
+            chan->conn = Connection::build(self.shared_from_this(), serv, chan->prio);
 
             chan->conn->pending[chan->cid] = chan;
             chan->state = Channel::Connecting;
@@ -868,6 +873,8 @@ void ContextImpl::tickSearch()
     decltype (searchBuckets)::value_type bucket;
     searchBuckets[idx].swap(bucket);
 
+    searchBatch.clear();
+
     while(!bucket.empty()) {
         searchMsg.resize(0x10000);
         FixedBuf M(true, searchMsg.data(), searchMsg.size());
@@ -961,27 +968,11 @@ void ContextImpl::tickSearch()
             FixedBuf H(true, searchMsg.data(), 8);
             to_wire(H, Header{CMD_SEARCH, 0, uint32_t(consumed-8u)});
         }
+        // queue one copy per destination, sent together below
         for(auto& pair : searchDest) {
             *pflags = pair.second ? 0x80 : 0x00;
 
-            int ntx = sendto(searchTx.sock, (char*)searchMsg.data(), consumed, 0, &pair.first->sa, pair.first.size());
-
-            if(ntx<0) {
-                int err = evutil_socket_geterror(searchTx.sock);
-                auto lvl = Level::Warn;
-                if(err==EINTR || err==EPERM)
-                    lvl = Level::Debug;
-                log_printf(io, lvl, "Search tx error (%d) %s\n",
-                           err, evutil_socket_error_to_string(err));
-
-            } else if(unsigned(ntx)<consumed) {
-                log_warn_printf(io, "Search truncated %u < %u",
-                           unsigned(ntx), unsigned(consumed));
-
-            } else {
-                log_debug_printf(io, "Search to %s %s\n", pair.first.tostring().c_str(),
-                                 pair.second ? "ucast" : "bcast");
-            }
+            searchBatch.push(searchMsg.data(), consumed, pair.first);
         }
         *pflags |= 0x80; // TCP search is always "unicast"
         // TCP search replies should always come back on the same connection,
@@ -1007,6 +998,27 @@ void ContextImpl::tickSearch()
 
     }
 
+    searchBatch.send(searchTx.sock);
+
+    for(auto i : range(searchBatch.size())) {
+        auto& msg = searchBatch[i];
+
+        if(msg.ntx<0) {
+            auto lvl = Level::Warn;
+            if(msg.err==EINTR || msg.err==EPERM)
+                lvl = Level::Debug;
+            log_printf(io, lvl, "Search tx error (%d) %s\n",
+                       msg.err, evutil_socket_error_to_string(msg.err));
+
+        } else if(size_t(msg.ntx)<msg.len) {
+            log_warn_printf(io, "Search truncated %u < %u",
+                       unsigned(msg.ntx), unsigned(msg.len));
+
+        } else {
+            log_debug_printf(io, "Search to %s\n", msg.dest.tostring().c_str());
+        }
+    }
+
     if(event_add(searchTimer.get(), &bucketInterval))
         log_err_printf(setup, "Error re-enabling search timer on\n%s", "");
 }
@@ -1081,7 +1093,7 @@ void ContextImpl::cacheClean(const std::string& name, Context::cacheAction actio
     while(next!=end) {
         auto cur(next++);
 
-        if(!name.empty() && cur->first.first!=name)
+        if(!name.empty() && std::get<0>(cur->first)!=name)
             continue;
 
         else if(action!=Context::Clean || cur->second.use_count()<=1) {
@@ -1090,11 +1102,11 @@ void ContextImpl::cacheClean(const std::string& name, Context::cacheAction actio
             if(action==Context::Clean && !cur->second->garbage) {
                 // mark for next sweep
                 log_debug_printf(setup, "Chan GC mark '%s':'%s'\n",
-                                 cur->first.first.c_str(), cur->first.second.c_str());
+                                 std::get<0>(cur->first).c_str(), std::get<1>(cur->first).c_str());
 
             } else {
                 log_debug_printf(setup, "Chan GC sweep '%s':'%s'\n",
-                                 cur->first.first.c_str(), cur->first.second.c_str());
+                                 std::get<0>(cur->first).c_str(), std::get<1>(cur->first).c_str());
 
                 auto trash(std::move(cur->second));
 
@@ -14,7 +14,7 @@ namespace client {
 
 DEFINE_LOGGER(io, "pvxs.client.io");
 
-Connection::Connection(const std::shared_ptr<ContextImpl>& context, const SockAddr& peerAddr)
+Connection::Connection(const std::shared_ptr<ContextImpl>& context, const SockAddr& peerAddr, unsigned prio)
     :ConnBase (true,
                bufferevent_socket_new(context->tcp_loop.base, -1, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
                peerAddr)
@@ -23,6 +23,8 @@ Connection::Connection(const std::shared_ptr<ContextImpl>& context, const SockAd
 {
     bufferevent_setcb(bev.get(), &bevReadS, nullptr, &bevEventS, this);
 
+    setPriority(prio);
+
     // shorter timeout until connect() ?
     timeval tmo(totv(context->effective.tcpTimeout));
     bufferevent_set_timeouts(bev.get(), &tmo, &tmo);
@@ -40,12 +42,14 @@ Connection::~Connection()
 }
 
 std::shared_ptr<Connection> Connection::build(const std::shared_ptr<ContextImpl>& context,
-                                              const SockAddr& serv)
+                                              const SockAddr& serv,
+                                              unsigned prio)
 {
     std::shared_ptr<Connection> ret;
-    auto it = context->connByAddr.find(serv);
+    auto key(std::make_pair(serv, prio));
+    auto it = context->connByAddr.find(key);
     if(it==context->connByAddr.end() || !(ret = it->second.lock())) {
-        context->connByAddr[serv] = ret = std::make_shared<Connection>(context, serv);
+        context->connByAddr[key] = ret = std::make_shared<Connection>(context, serv, prio);
     }
     return ret;
 }
@@ -128,7 +132,7 @@ void Connection::cleanup()
 {
     ready = false;
 
-    context->connByAddr.erase(peerAddr);
+    context->connByAddr.erase(std::make_pair(peerAddr, priority));
 
     if(bev)
         bev.reset();
@@ -238,8 +242,8 @@ void Connection::handle_CONNECTION_VALIDATION()
         to_wire(R, uint32_t(0x10000));
         // serverIntrospectionRegistryMaxSize, also not used
         to_wire(R, uint16_t(0x7fff));
-        // QoS, not used (quality?)
-        to_wire(R, uint16_t(0));
+        // QoS, aka. connection priority
+        to_wire(R, uint16_t(priority));
 
         to_wire(R, selected);
 
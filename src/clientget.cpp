@@ -571,6 +571,7 @@ static
 std::shared_ptr<Operation> gpr_setup(const std::shared_ptr<ContextImpl>& context,
                                      std::string name, // need to capture by value
                                      std::string server,
+                                     unsigned prio,
                                      std::shared_ptr<GPROp>&& op,
                                      bool syncCancel)
 {
@@ -592,10 +593,10 @@ std::shared_ptr<Operation> gpr_setup(const std::shared_ptr<ContextImpl>& context
                        }, std::move(temp)));
     });
 
-    context->tcp_loop.dispatch([internal, context, name, server]() {
+    context->tcp_loop.dispatch([internal, context, name, server, prio]() {
         // on worker
 
-        internal->chan = Channel::build(context, name, server);
+        internal->chan = Channel::build(context, name, server, prio);
 
         internal->chan->pending.push_back(internal);
         internal->chan->createOperations();
@@ -617,7 +618,7 @@ std::shared_ptr<Operation> GetBuilder::_exec_get()
     op->autoExec = _autoexec;
     op->pvRequest = _buildReq();
 
-    return gpr_setup(context, _name, _server, std::move(op), _syncCancel);
+    return gpr_setup(context, _name, _server, _prio, std::move(op), _syncCancel);
 }
 
 std::shared_ptr<Operation> PutBuilder::exec()
@@ -647,7 +648,7 @@ std::shared_ptr<Operation> PutBuilder::exec()
     op->autoExec = _autoexec;
     op->pvRequest = _buildReq();
 
-    return gpr_setup(context, _name, _server, std::move(op), _syncCancel);
+    return gpr_setup(context, _name, _server, _prio, std::move(op), _syncCancel);
 }
 
 std::shared_ptr<Operation> RPCBuilder::exec()
@@ -672,7 +673,7 @@ std::shared_ptr<Operation> RPCBuilder::exec()
     op->autoExec = _autoexec;
     op->pvRequest = _buildReq();
 
-    return gpr_setup(context, _name, _server, std::move(op), _syncCancel);
+    return gpr_setup(context, _name, _server, _prio, std::move(op), _syncCancel);
 }
 
 } // namespace client
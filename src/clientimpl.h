@@ -7,6 +7,7 @@
 #define CLIENTIMPL_H
 
 #include <list>
+#include <tuple>
 
 #include <epicsTime.h>
 #include <epicsEvent.h>
@@ -93,12 +94,13 @@ struct Connection : public ConnBase, public std::enable_shared_from_this<Connect
 
     INST_COUNTER(Connection);
 
-    Connection(const std::shared_ptr<ContextImpl>& context, const SockAddr &peerAddr);
+    Connection(const std::shared_ptr<ContextImpl>& context, const SockAddr &peerAddr, unsigned prio);
     virtual ~Connection();
 
     static
     std::shared_ptr<Connection> build(const std::shared_ptr<ContextImpl>& context,
-                                      const SockAddr& serv);
+                                      const SockAddr& serv,
+                                      unsigned prio=0u);
 
     void createChannels();
 
@@ -173,6 +175,9 @@ struct Channel {
     // channel created with .server() to bypass normal search process
     SockAddr forcedServer;
 
+    // requested with .priority().  Selects the Connection to a server
+    unsigned prio = 0u;
+
     // when state==Searching, number of repetitions
     size_t nSearch = 0u;
 
@@ -200,7 +205,8 @@ struct Channel {
     static
     std::shared_ptr<Channel> build(const std::shared_ptr<ContextImpl>& context,
                                    const std::string& name,
-                                   const std::string& server);
+                                   const std::string& server,
+                                   unsigned prio=0u);
 };
 
 struct ContextImpl : public std::enable_shared_from_this<ContextImpl>
@@ -232,6 +238,8 @@ struct ContextImpl : public std::enable_shared_from_this<ContextImpl>
     std::map<SockAddr, BTrack> beaconSenders;
 
     std::vector<uint8_t> searchMsg;
+    // UDP search packets queued during one tickSearch()
+    UDPTxBatch searchBatch;
 
     // search destination address and whether to set the unicast flag
     std::vector<std::pair<SockAddr, bool>> searchDest;
@@ -244,10 +252,11 @@ struct ContextImpl : public std::enable_shared_from_this<ContextImpl>
     std::map<uint32_t, std::weak_ptr<Channel>> chanByCID;
     // strong ref. loop through Channel::context
     // explicitly broken by Context::close(), Context::cacheClear(), or ContextImpl::cacheClean()
-    // chanByName key'd by (pv, forceServer)
-    std::map<std::pair<std::string, std::string>, std::shared_ptr<Channel>> chanByName;
+    // chanByName key'd by (pv, forceServer, priority)
+    std::map<std::tuple<std::string, std::string, unsigned>, std::shared_ptr<Channel>> chanByName;
 
-    std::map<SockAddr, std::weak_ptr<Connection>> connByAddr;
+    // one Connection per server and priority
+    std::map<std::pair<SockAddr, unsigned>, std::weak_ptr<Connection>> connByAddr;
 
     std::vector<std::pair<SockAddr, std::shared_ptr<Connection>>> nameServers;
 
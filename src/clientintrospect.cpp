@@ -214,10 +214,11 @@ std::shared_ptr<Operation> GetBuilder::_exec_info()
 
     auto name(std::move(_name));
     auto server(std::move(_server));
-    context->tcp_loop.dispatch([op, context, name, server]() {
+    auto prio(_prio);
+    context->tcp_loop.dispatch([op, context, name, server, prio]() {
         // on worker
 
-        op->chan = Channel::build(context, name, server);
+        op->chan = Channel::build(context, name, server, prio);
 
         op->chan->pending.push_back(op);
         op->chan->createOperations();
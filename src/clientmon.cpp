@@ -674,10 +674,11 @@ std::shared_ptr<Subscription> MonitorBuilder::exec()
 
     auto name(std::move(_name));
     auto server(std::move(_server));
-    context->tcp_loop.dispatch([op, context, name, server]() {
+    auto prio(_prio);
+    context->tcp_loop.dispatch([op, context, name, server, prio]() {
         // on worker
 
-        op->chan = Channel::build(context, name, server);
+        op->chan = Channel::build(context, name, server, prio);
 
         op->chan->pending.push_back(op);
         op->chan->createOperations();
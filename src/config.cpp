@@ -303,6 +303,9 @@ void Config::expand()
     removeDups(ignoreAddrs);
 
     enforceTimeout(tcpTimeout);
+
+    if(tcpWorkers==0u)
+        tcpWorkers = 1u;
 }
 
 std::ostream& operator<<(std::ostream& strm, const Config& conf)
@@ -5,6 +5,7 @@
  */
 
 #include <limits>
+#include <algorithm>
 
 #include <epicsAssert.h>
 
@@ -43,14 +44,53 @@ size_t ConnBase::enqueueTxBody(pva_app_msg_t cmd)
 {
     auto blen = evbuffer_get_length(txBody.get());
     auto tx = bufferevent_get_output(bev.get());
-    to_evbuf(tx, Header{cmd,
-                        uint8_t(isClient ? 0u : pva_flags::Server),
-                        uint32_t(blen)},
-             hostBE);
-    auto err = evbuffer_add_buffer(tx, txBody.get());
-    assert(!err);
-    statTx += 8u + blen;
-    return 8u + blen;
+    uint8_t flags = isClient ? 0u : pva_flags::Server;
+
+    if(!txSegment || blen <= txSegment) {
+        to_evbuf(tx, Header{cmd, flags, uint32_t(blen)}, hostBE);
+        auto err = evbuffer_add_buffer(tx, txBody.get());
+        assert(!err);
+        statTx += 8u + blen;
+        return 8u + blen;
+    }
+
+    size_t total = 0u;
+    for(size_t remaining = blen; remaining;) {
+        auto n = std::min(remaining, txSegment);
+
+        uint8_t seg;
+        if(remaining==blen)
+            seg = pva_flags::SegFirst;
+        else if(remaining==n)
+            seg = pva_flags::SegLast;
+        else
+            seg = pva_flags::SegMask; // middle
+
+        to_evbuf(tx, Header{cmd, uint8_t(flags|seg), uint32_t(n)}, hostBE);
+        // moves complete chains, copies partial chains
+        auto moved = evbuffer_remove_buffer(txBody.get(), tx, n);
+        assert(moved==int(n));
+
+        remaining -= n;
+        total += 8u + n;
+    }
+    statTx += total;
+    return total;
+}
+
+void ConnBase::setPriority(unsigned prio)
+{
+    priority = std::min(prio, pva_max_priority);
+
+    // the worker services ready connections with a non-zero priority first,
+    // and maps 1 -> pva_max_priority to bands below the default level.
+    constexpr unsigned nbands = evbase_default_priority;
+    int level = nbands;
+    if(priority)
+        level = int(nbands - 1u - (priority-1u)*nbands/pva_max_priority);
+
+    if(bev && !prioBound.set(level))
+        log_warn_printf(connsetup, "%s %s unable to set priority %u\n", peerLabel(), peerName.c_str(), priority);
 }
 
 #define CASE(Op) void ConnBase::handle_##Op() {}
@@ -144,22 +184,29 @@ void ConnBase::bevRead()
                 readahead += tcp_readahead;
             bufferevent_setwatermark(bev.get(), EV_READ, len, readahead);
             bufferevent_enable(bev.get(), EV_READ);
+
+            if(len > tcp_readahead) {
+                // Ask that the remainder of a long body be received into one segment.
+                // Allows large arrays to be decoded without copying.  cf. EvInBuf::takeRef()
+                (void)evbuffer_expand(rx, 8u + len - evbuffer_get_length(rx));
+            }
             return;
         }
 
+        auto seg = header[2]&pva_flags::SegMask;
+
         evbuffer_drain(rx, 8);
-        {
+        if(!seg) {
             unsigned n = evbuffer_remove_buffer(rx, segBuf.get(), len);
             assert(n==len); // we know rx buf contains the entire body
+        } else {
+            // Handlers decode complete messages, so all segments of a message
+            // are accumulated prior to parsing.  Collect them into a few
+            // large chains, which are released progressively during decode.
+            segCollect.append(segBuf.get(), rx, len);
         }
         statRx += 8u + len;
 
-        // so far we do not use segmentation to support incremental processing
-        // of long messages.  We instead accumulate all segments of a message
-        // prior to parsing.
-
-        auto seg = header[2]&pva_flags::SegMask;
-
         bool continuation = seg&pva_flags::SegLast; // true for mid or last.  false for none or first
         if((continuation ^ expectSeg) || (continuation && header[3]!=segCmd)) {
             log_crit_printf(connio, "%s %s Peer segmentation violation %c%c 0x%02x==0x%02x\n", peerLabel(), peerName.c_str(),
@@ -176,6 +223,7 @@ void ConnBase::bevRead()
 
         if(!seg || seg==pva_flags::SegLast) {
             expectSeg = false;
+            segCollect.reset();
 
             // ready to process segBuf
             try {
@@ -251,6 +299,7 @@ void ConnBase::bevReadS(struct bufferevent *bev, void *ptr)
 {
     auto conn = static_cast<ConnBase*>(ptr)->self_from_this();
     try {
+        conn->prioBound.tick();
         conn->bevRead();
     }catch(std::exception& e){
         log_exc_printf(connsetup, "%s %s Unhandled error in bev read callback: %s\n", conn->peerLabel(), conn->peerName.c_str(), e.what());
@@ -262,6 +311,7 @@ void ConnBase::bevWriteS(struct bufferevent *bev, void *ptr)
 {
     auto conn = static_cast<ConnBase*>(ptr)->self_from_this();
     try {
+        conn->prioBound.tick();
         conn->bevWrite();
     }catch(std::exception& e){
         log_exc_printf(connsetup, "%s %s Unhandled error in bev write callback: %s\n", conn->peerLabel(), conn->peerName.c_str(), e.what());
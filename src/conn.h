@@ -32,9 +32,17 @@ struct ConnBase
 
     uint8_t segCmd;
     evbuf segBuf, txBody;
+    SegCollector segCollect;
 
     size_t statTx{}, statRx{};
 
+    // segment outgoing message bodies longer than this.  zero to disable
+    size_t txSegment{};
+
+    // 0 -> pva_max_priority
+    unsigned priority{};
+    BoundedPriority prioBound{bev};
+
     ConnBase(bool isClient, bufferevent* bev, const SockAddr& peerAddr);
     ConnBase(const ConnBase&) = delete;
     ConnBase& operator=(const ConnBase&) = delete;
@@ -44,6 +52,8 @@ struct ConnBase
 
     size_t enqueueTxBody(pva_app_msg_t cmd);
 
+    void setPriority(unsigned prio);
+
 protected:
 #define CASE(Op) virtual void handle_##Op();
     CASE(ECHO);
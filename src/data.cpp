@@ -6,12 +6,15 @@
 
 #include <cstring>
 #include <epicsAssert.h>
+#include <epicsGuard.h>
 
 #include "dataimpl.h"
 #include "utilpvt.h"
 
 namespace pvxs {
 
+typedef epicsGuard<epicsMutex> Guard;
+
 NoField::NoField()
     :std::runtime_error ("No such field")
 {}
@@ -26,12 +29,24 @@ LookupError::LookupError(const std::string& msg)
 
 LookupError::~LookupError() {}
 
+namespace {
+// propagate mark to fields (Union or Any) which enclose this Value
+void markEnclosing(impl::StructTop* top)
+{
+    std::shared_ptr<impl::FieldStorage> enc;
+    while(top && (enc=top->enclosing.lock())) {
+        enc->valid = true;
+        top = enc->top();
+    }
+}
+} // namespace
+
 
 std::shared_ptr<const impl::FieldDesc>
 Value::Helper::type(const Value& v)
 {
     if(v) {
-        return std::shared_ptr<const impl::FieldDesc>(v.store->top->desc, v.desc);
+        return std::shared_ptr<const impl::FieldDesc>(v.store->top()->desc, v.desc);
     } else {
         return nullptr;
     }
@@ -97,34 +112,22 @@ Value::Value(const std::shared_ptr<const impl::FieldDesc>& desc)
     if(!desc)
         return;
 
-    auto top = std::make_shared<StructTop>();
-
-    top->desc = desc;
-    top->members.resize(desc->size());
-    {
-        auto& root = top->members[0];
-        root.init(desc->code.storedAs());
-        root.top = top.get();
-    }
+    auto top = StructTop::create(desc);
 
-    if(desc->code==TypeCode::Struct) {
-        for(auto& pair : desc->mlookup) {
-            auto cfld = desc.get() + pair.second;
-            auto& mem = top->members.at(pair.second);
-            mem.top = top.get();
-            mem.init(cfld->code.storedAs());
-        }
+    // for Struct, all descendants.  Otherwise only the root
+    for(auto i : range(top->nmembers)) {
+        top->members[i].init(desc.get()[i].code.storedAs());
     }
 
     this->desc = desc.get();
-    decltype (store) val(top, top->members.data()); // alias
+    decltype (store) val(top, top->members); // alias
     this->store = std::move(val);
 }
 
 Value::Value(const std::shared_ptr<const impl::FieldDesc>& desc, Value& parent)
     :Value(desc)
 {
-    store->top->enclosing = parent.store;
+    store->top()->enclosing = parent.store;
 }
 
 Value::~Value() {}
@@ -133,7 +136,7 @@ Value Value::cloneEmpty() const
 {
     Value ret;
     if(desc) {
-        decltype (store->top->desc) fld(store->top->desc, desc);
+        decltype (store->top()->desc) fld(store->top()->desc, desc);
         ret = Value(fld);
     }
     return ret;
@@ -143,7 +146,7 @@ Value Value::clone() const
 {
     Value ret;
     if(desc) {
-        decltype (store->top->desc) fld(store->top->desc, desc);
+        decltype (store->top()->desc) fld(store->top()->desc, desc);
         ret = Value(fld);
         ret.assign(*this);
     }
@@ -155,7 +158,12 @@ Value& Value::assign(const Value& o)
     if(!store || !o.store)
         throw std::logic_error("Can't assign() to/from empty Value");
 
-    if(type().kind()==Kind::Compound) {
+    if(desc==o.desc && desc->code==TypeCode::Struct) {
+        // Same type (common as types are interned).
+        // Copy marked fields by index, without name lookup or conversion.
+        copyMarked(o);
+
+    } else if(type().kind()==Kind::Compound) {
         // pass through Struct and others w/ type
         copyIn(&o, StoreType::Compound);
     } else {
@@ -165,13 +173,132 @@ Value& Value::assign(const Value& o)
     return *this;
 }
 
+void Value::copyMarked(const Value& o)
+{
+    bool changed = false;
+
+    auto dst = store.get();
+    auto src = o.store.get();
+
+    // descendants of this Struct.  cf. copyIn() for the general case.
+    for(auto i : range(size_t(1u), desc->size())) {
+        auto& sfld = src[i];
+        if(!sfld.valid)
+            continue;
+
+        auto& dfld = dst[i];
+
+        switch(sfld.code) {
+        case StoreType::Null: // sub-struct.  members marked individually
+            break;
+        case StoreType::Bool:
+        case StoreType::Integer:
+        case StoreType::UInteger:
+        case StoreType::Real:
+            memcpy(dfld.buffer(), sfld.buffer(), sizeof(uint64_t));
+            break;
+        case StoreType::String:
+            dfld.as<std::string>() = sfld.as<std::string>();
+            break;
+        case StoreType::Array: {
+            if(dfld.code!=StoreType::Array) { // column-wise Struct[]
+                dfld.deinit();
+                dfld.init(StoreType::Array);
+            }
+            auto& sarr = sfld.as<shared_array<const void>>();
+            auto& darr = dfld.as<shared_array<const void>>();
+            if(sarr.empty())
+                darr.clear();
+            else
+                darr = sarr;
+            break;
+        }
+        case StoreType::Compound: {
+            // Union, Any, or column-wise Struct[].  Needs selection and (maybe) allocation
+            Value fld;
+            fld.store = decltype(store)(store, &dfld);
+            fld.desc = desc + i;
+            fld.copyIn(&sfld.store, StoreType::Compound);
+            break;
+        }
+        }
+
+        dfld.valid = true;
+        changed = true;
+    }
+
+    if(o.isMarked())
+        mark();
+    else if(changed)
+        markEnclosing(store->top());
+}
+
+Value Value::columns() const
+{
+    if(!desc || desc->code!=TypeCode::StructA || !desc->columns)
+        throw NoConvert(SB()<<"columns() not possible for "<<type());
+
+    Value ret(desc->columns);
+    auto cdesc = desc->columns.get();
+    auto cstore = ret.store.get();
+
+    if(store->code==StoreType::Compound) {
+        // already column-wise.  share arrays
+        auto sstore = store->as<Value>().store.get();
+        for(auto i : range(cdesc->size())) {
+            if(cstore[i].code==StoreType::Array) {
+                cstore[i].as<shared_array<const void>>() = sstore[i].as<shared_array<const void>>();
+                cstore[i].valid = true;
+            }
+        }
+
+    } else {
+        // transpose elements
+        auto& varr = store->as<shared_array<const void>>();
+        shared_array<const Value> rows;
+        if(varr.original_type()==ArrayType::Value)
+            rows = varr.castTo<const Value>();
+
+        for(auto& elem : rows) {
+            if(!elem)
+                throw NoConvert("columns() can't represent a null element");
+        }
+
+        for(auto i : range(cdesc->size())) {
+            if(cstore[i].code!=StoreType::Array)
+                continue; // sub-struct
+
+            auto arr(allocArray(cdesc[i].code.arrayType(), rows.size()));
+            auto base = arr.data();
+
+            for(auto r : range(rows.size())) {
+                auto& fld = rows[r].store.get()[i];
+
+                switch(cdesc[i].code.scalarOf().code) {
+#define CASE(CODE, TYPE, STORE) \
+                case TypeCode::CODE: static_cast<TYPE*>(base)[r] = TYPE(fld.as<STORE>()); break;
+                COLUMN_TYPES(CASE)
+#undef CASE
+                default:
+                    throw std::logic_error("Invalid column type");
+                }
+            }
+
+            cstore[i].as<shared_array<const void>>() = arr.freeze();
+            cstore[i].valid = true;
+        }
+    }
+
+    return ret;
+}
+
 Value Value::allocMember()
 {
     // allocate member type for Struct[] or Union[]
     if(!desc || (desc->code!=TypeCode::UnionA && desc->code!=TypeCode::StructA))
         throw std::runtime_error("allocMember() only meaningful for Struct[] or Union[]");
 
-    decltype (store->top->desc) fld(store->top->desc, desc->members.data());
+    decltype (store->top()->desc) fld(store->top()->desc, desc->members.data());
     return Value::Helper::build(fld, *this);
 }
 
@@ -183,7 +310,7 @@ bool Value::isMarked(bool parents, bool children) const
     if(store->valid)
         return true;
 
-    auto top = store->top;
+    auto top = store->top();
 
     if(children && desc->size()>1u) {
         // TODO more efficient
@@ -224,15 +351,8 @@ void Value::mark(bool v)
         return;
 
     store->valid = v;
-    if(!v)
-        return;
-
-    auto top = store->top;
-    std::shared_ptr<FieldStorage> enc;
-    while(top && (enc=top->enclosing.lock())) {
-        enc->valid = true;
-        top = enc->top;
-    }
+    if(v)
+        markEnclosing(store->top());
 }
 
 void Value::unmark(bool parents, bool children)
@@ -242,7 +362,7 @@ void Value::unmark(bool parents, bool children)
 
     store->valid = false;
 
-    auto top = store->top;
+    auto top = store->top();
 
     if(children && desc->size()>1u) {
         // TODO more efficient
@@ -271,7 +391,11 @@ TypeCode Value::type() const
 
 StoreType Value::storageType() const
 {
-    return store ? store->code : StoreType::Null;
+    if(!store)
+        return StoreType::Null;
+    else if(desc->code==TypeCode::StructA)
+        return StoreType::Array; // even when column-wise
+    return store->code;
 }
 
 const std::string& Value::id() const
@@ -383,6 +507,18 @@ bool copyOutScalar(const Src& src, void *ptr, StoreType type)
 
 void Value::copyOut(void *ptr, StoreType type) const
 {
+    if(desc && desc->code==TypeCode::StructA && store->code==StoreType::Compound) {
+        // column-wise Struct[].  Create elements
+        if(type==StoreType::Array) {
+            auto n = columnsLength(store->as<Value>());
+            shared_array<Value> rows(n);
+            columnsToRows(rows, n, desc, store);
+            *reinterpret_cast<shared_array<const void>*>(ptr) = rows.freeze().castTo<const void>();
+            return;
+        }
+        throw NoConvert(SB()<<"Can't extract "<<this->type()<<" as "<<type);
+    }
+
     if(!desc)
         throw NoField();
 
@@ -505,6 +641,43 @@ void Value::copyIn(const void *ptr, StoreType type)
     if(!desc)
         throw NoField();
 
+    if(desc->code==TypeCode::StructA && (type==StoreType::Compound || store->code==StoreType::Compound)) {
+        if(type==StoreType::Compound) {
+            // store column-wise.  cf. columns()
+            auto& src = *reinterpret_cast<const Value*>(ptr);
+            if(!src.desc || src.desc!=desc->columns.get())
+                throw NoConvert(SB()<<"Unable to assign "<<desc->code<<" with "<<src.type()<<" which is not columns()");
+
+            auto n = columnsLength(src);
+            Value cols(src.cloneEmpty());
+            for(auto i : range(src.desc->size())) {
+                auto& sfld = src.store.get()[i];
+                if(sfld.code!=StoreType::Array)
+                    continue;
+                auto& arr = sfld.as<shared_array<const void>>();
+                if(arr.size()!=n)
+                    throw NoConvert(SB()<<"Unable to assign "<<desc->code<<" with columns of different lengths");
+                auto& dfld = cols.store.get()[i];
+                dfld.as<shared_array<const void>>() = arr;
+                dfld.valid = true;
+            }
+
+            store->deinit();
+            store->init(StoreType::Compound);
+            store->as<Value>() = std::move(cols);
+            mark();
+            return;
+
+        } else if(type==StoreType::Array) {
+            // replacing column-wise with element-wise
+            store->deinit();
+            store->init(StoreType::Array);
+
+        } else {
+            throw NoConvert(SB()<<"Unable to assign "<<desc->code<<" with "<<type);
+        }
+    }
+
     switch(store->code) {
     case StoreType::Real: {
         if(!copyInScalar(store->as<double>(), ptr, type)) throw NoConvert(SB()<<"Unable to assign "<<desc->code<<" with "<<type);
@@ -638,7 +811,7 @@ void Value::copyIn(const void *ptr, StoreType type)
                     if(src.desc!=&desc->members[idx])
                         continue;
 
-                    std::shared_ptr<const FieldDesc> udesc(store->top->desc, &desc->members[idx]);
+                    std::shared_ptr<const FieldDesc> udesc(store->top()->desc, &desc->members[idx]);
                     Value temp(udesc, *this);
                     temp.assign(src);
                     val = std::move(temp);
@@ -653,7 +826,7 @@ void Value::copyIn(const void *ptr, StoreType type)
                 // attempt convenient, but inefficient auto-selection
                 for(auto i : range(desc->miter.size())) {
                     auto idx(desc->miter[i].second);
-                    std::shared_ptr<const FieldDesc> udesc(store->top->desc, &desc->members[idx]);
+                    std::shared_ptr<const FieldDesc> udesc(store->top()->desc, &desc->members[idx]);
                     Value temp(udesc, *this);
                     try{
                         temp.copyIn(ptr, type);
@@ -733,7 +906,7 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
     while(desc && pos<expr.size()) {
         if(expr[pos]=='<') {
             // attempt traverse to parent
-            if(desc!=store->top->desc.get())
+            if(desc!=store->top()->desc.get())
             {
                 auto pdesc = desc - desc->parent_index;
                 std::shared_ptr<FieldStorage> pstore(store, store.get() - desc->parent_index);
@@ -818,7 +991,7 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
                             // will select, or already selected
                             if(fld.desc!=&desc->members[it->second]) {
                                 // select
-                                std::shared_ptr<const FieldDesc> mtype(store->top->desc, &desc->members[it->second]);
+                                std::shared_ptr<const FieldDesc> mtype(store->top()->desc, &desc->members[it->second]);
                                 fld = Value(mtype, *this);
                             }
                             pos = sep;
@@ -864,7 +1037,24 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
                     && sep!=std::string::npos && sep-pos>=2)
             {
                 auto index = parseTo<uint64_t>(expr.substr(pos+1, sep-1-pos));
-                auto& varr = store->as<shared_array<const void>>();
+
+                if(desc->code==TypeCode::StructA && store->code==StoreType::Compound) {
+                    // column-wise Struct[]
+                    if(modify) {
+                        // element may be changed through the result.  Switch to element-wise.
+                        columnsToElements(desc, store);
+
+                    } else if(index < columnsLength(store->as<Value>())) {
+                        // create only the requested element
+                        *this = columnsToRow(desc, store, index);
+                        pos = sep+1;
+                        maybedot = true;
+                        continue;
+                    }
+                }
+
+                shared_array<const void> varr;
+                copyOut(&varr, StoreType::Array);
                 shared_array<const Value> arr;
                 if((varr.original_type()==ArrayType::Value)
                         && index < (arr = varr.castTo<const Value>()).size())
@@ -927,6 +1117,71 @@ const Value Value::lookup(const std::string& name) const
     return ret;
 }
 
+FieldRef::FieldRef(const std::string& expr)
+    :expr(expr)
+{}
+
+FieldRef::FieldRef(const Value& proto, const std::string& expr)
+    :expr(expr)
+{
+    auto desc = Value::Helper::desc(proto);
+    if(!desc) {
+        // nothing to resolve against
+
+    } else if(expr.empty()) {
+        type = Value::Helper::type(proto);
+
+    } else if(desc->code.code==TypeCode::Struct && expr.find_first_of("<[-") == std::string::npos) {
+        // only Struct members.  mlookup already maps full "a.b.c" names of all descendants.
+        auto it = desc->mlookup.find(expr);
+        if(it!=desc->mlookup.end()) {
+            type = Value::Helper::type(proto);
+            offset = it->second;
+        }
+    }
+    // otherwise unresolved, fall back to traverse()
+}
+
+Value Value::operator[](const FieldRef& ref)
+{
+    Value ret(*this);
+    if(desc && desc==ref.type.get()) {
+        decltype(store) value(store, store.get()+ref.offset);
+        ret.store = std::move(value);
+        ret.desc = desc+ref.offset;
+    } else {
+        ret.traverse(ref.expr, true, false);
+    }
+    return ret;
+}
+
+const Value Value::operator[](const FieldRef& ref) const
+{
+    Value ret(*this);
+    if(desc && desc==ref.type.get()) {
+        decltype(store) value(store, store.get()+ref.offset);
+        ret.store = std::move(value);
+        ret.desc = desc+ref.offset;
+    } else {
+        ret.traverse(ref.expr, false, false);
+    }
+    return ret;
+}
+
+Value Value::lookup(const FieldRef& ref)
+{
+    if(desc && desc==ref.type.get())
+        return (*this)[ref];
+    return lookup(ref.expr);
+}
+
+const Value Value::lookup(const FieldRef& ref) const
+{
+    if(desc && desc==ref.type.get())
+        return (*this)[ref];
+    return lookup(ref.expr);
+}
+
 size_t Value::nmembers() const
 {
     switch(desc ? desc->code.code : TypeCode::Null) {
@@ -1133,6 +1388,23 @@ Value::_Iterator<Value::_IMarked>::operator++() noexcept
     return *this;
 }
 
+void setValuePoolLimit(size_t limit)
+{
+    impl::StructPool::limit.store(limit, std::memory_order_relaxed);
+    if(!limit) {
+        impl::StructPool::nhit.store(0u, std::memory_order_relaxed);
+        impl::StructPool::nmiss.store(0u, std::memory_order_relaxed);
+    }
+}
+
+ValuePoolStats valuePoolStats()
+{
+    ValuePoolStats ret;
+    ret.hit = impl::StructPool::nhit.load(std::memory_order_relaxed);
+    ret.miss = impl::StructPool::nmiss.load(std::memory_order_relaxed);
+    return ret;
+}
+
 namespace impl {
 
 void FieldStorage::init(StoreType code)
@@ -1154,7 +1426,7 @@ void FieldStorage::init(StoreType code)
         new(&store) std::string();
         return;
     case StoreType::Compound:
-        new(&store) std::shared_ptr<FieldStorage>();
+        new(&store) Value();
         return;
     case StoreType::Array:
         new(&store) shared_array<void>();
@@ -1192,10 +1464,213 @@ FieldStorage::~FieldStorage()
     deinit();
 }
 
-size_t FieldStorage::index() const
+size_t columnsLength(const Value& cols)
 {
-    const size_t ret = this-top->members.data();
+    auto desc = Value::Helper::desc(cols);
+    auto store = Value::Helper::store_ptr(cols);
+    for(auto i : range(desc->size())) {
+        if(store[i].code==StoreType::Array)
+            return store[i].as<shared_array<const void>>().size();
+    }
+    return 0u;
+}
+
+Value columnsToRow(const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store, size_t r)
+{
+    auto& cols = store->as<Value>();
+    auto cdesc = Value::Helper::desc(cols);
+    auto cstore = Value::Helper::store_ptr(cols);
+    std::shared_ptr<const FieldDesc> etype(store->top()->desc, &desc->members[0]); // alias
+
+    auto elem = Value::Helper::build(etype, store, desc);
+    auto estore = Value::Helper::store_ptr(elem);
+
+    // Element and column types have the same layout.  Leaves are at the same index.
+    for(auto i : range(size_t(1u), cdesc->size())) {
+        if(cstore[i].code!=StoreType::Array)
+            continue; // sub-struct
+        auto base = cstore[i].as<shared_array<const void>>().data();
+        auto& fld = estore[i];
+
+        switch(cdesc[i].code.scalarOf().code) {
+#define CASE(CODE, TYPE, STORE) \
+        case TypeCode::CODE: fld.as<STORE>() = static_cast<const TYPE*>(base)[r]; break;
+        COLUMN_TYPES(CASE)
+#undef CASE
+        default:
+            throw std::logic_error("Invalid column type");
+        }
+        fld.valid = true;
+    }
+
+    return elem;
+}
+
+void columnsToRows(shared_array<Value>& rows, size_t n,
+                   const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store)
+{
+    for(auto r : range(n)) {
+        rows[r] = columnsToRow(desc, store, r);
+    }
+}
+
+void columnsToElements(const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store)
+{
+    auto n = columnsLength(store->as<Value>());
+    shared_array<Value> rows(n);
+    columnsToRows(rows, n, desc, store);
+
+    store->deinit();
+    store->init(StoreType::Array);
+    store->as<shared_array<const void>>() = rows.freeze().castTo<const void>();
+}
+
+std::atomic<size_t> StructPool::limit{0u};
+std::atomic<size_t> StructPool::nhit{0u};
+std::atomic<size_t> StructPool::nmiss{0u};
+
+StructPool::~StructPool()
+{
+    for(auto block : blocks) {
+        ::operator delete(block);
+    }
+    cnt_StructPoolFree.fetch_sub(blocks.size(), std::memory_order_relaxed);
+}
+
+void* StructPool::pop(size_t nbytes)
+{
+    void* ret = nullptr;
+    {
+        Guard G(lock);
+        if(nbytes==blockSize && !blocks.empty()) {
+            ret = blocks.back();
+            blocks.pop_back();
+        }
+    }
+    if(ret) {
+        cnt_StructPoolFree.fetch_sub(1u, std::memory_order_relaxed);
+        nhit.fetch_add(1u, std::memory_order_relaxed);
+    } else {
+        nmiss.fetch_add(1u, std::memory_order_relaxed);
+    }
     return ret;
 }
 
+bool StructPool::push(void* block, size_t nbytes)
+{
+    {
+        Guard G(lock);
+        if(blocks.empty())
+            blockSize = nbytes;
+        if(nbytes!=blockSize || blocks.size() >= limit.load(std::memory_order_relaxed))
+            return false;
+        try {
+            blocks.push_back(block);
+        }catch(std::bad_alloc&){
+            return false;
+        }
+    }
+    cnt_StructPoolFree.fetch_add(1u, std::memory_order_relaxed);
+    return true;
+}
+
+StructPool* StructPoolRef::get() const
+{
+    auto ret = pool.load(std::memory_order_acquire);
+    if(!ret) {
+        auto fresh = new StructPool;
+        // on failure, ret is updated with the pool created by another thread
+        if(pool.compare_exchange_strong(ret, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            ret = fresh;
+        else
+            delete fresh;
+    }
+    return ret;
+}
+
+namespace {
+/* Over-allocates to place a trailing array after the object created by std::allocate_shared().
+ * Draws from, and returns to, a StructPool if provided.
+ */
+template<typename T>
+struct TrailingAllocator {
+    typedef T value_type;
+
+    size_t extra;
+    void** trailing;
+    // borrowed.  Each allocation holds a reference
+    StructPool* pool;
+
+    TrailingAllocator(size_t extra, void** trailing, StructPool* pool)
+        :extra(extra), trailing(trailing), pool(pool)
+    {}
+    template<typename U>
+    TrailingAllocator(const TrailingAllocator<U>& o) :extra(o.extra), trailing(o.trailing), pool(o.pool) {}
+
+    static constexpr size_t align = alignof(FieldStorage) > alignof(T) ? alignof(FieldStorage) : alignof(T);
+
+    size_t base(size_t n) const {
+        return (n*sizeof(T) + align-1u) & ~(align-1u);
+    }
+
+    T* allocate(size_t n) {
+        const size_t nbytes = base(n) + extra;
+        void* raw = pool ? pool->pop(nbytes) : nullptr;
+        if(!raw)
+            raw = ::operator new(nbytes);
+        if(pool)
+            pool->ref();
+        *trailing = static_cast<char*>(raw) + base(n);
+        return static_cast<T*>(raw);
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        if(!pool) {
+            ::operator delete(p);
+        } else {
+            if(!pool->push(p, base(n) + extra))
+                ::operator delete(p);
+            pool->unref();
+        }
+    }
+
+    template<typename U>
+    bool operator==(const TrailingAllocator<U>& o) const { return trailing==o.trailing; }
+    template<typename U>
+    bool operator!=(const TrailingAllocator<U>& o) const { return trailing!=o.trailing; }
+};
+
+// space for the back pointer preceding StructTop::members
+constexpr size_t trailingHeader = alignof(FieldStorage) > sizeof(StructTop*) ? alignof(FieldStorage) : sizeof(StructTop*);
+} // namespace
+
+std::shared_ptr<StructTop> StructTop::create(const std::shared_ptr<const FieldDesc>& desc)
+{
+    const size_t nmembers = desc->size();
+    void* trailing = nullptr;
+    StructPool* pool = nullptr;
+    if(StructPool::limit.load(std::memory_order_relaxed))
+        pool = desc->pool.get();
+    auto top(std::allocate_shared<StructTop>(TrailingAllocator<StructTop>(trailingHeader + nmembers*sizeof(FieldStorage),
+                                                                          &trailing, pool)));
+    auto mem = static_cast<char*>(trailing) + trailingHeader;
+    reinterpret_cast<StructTop**>(mem)[-1] = top.get();
+
+    top->desc = desc;
+    top->members = reinterpret_cast<FieldStorage*>(mem);
+    for(auto i : range(nmembers)) {
+        auto fld = new(&top->members[i]) FieldStorage;
+        fld->idx = uint32_t(i);
+        top->nmembers++; // in case of exception
+    }
+    return top;
+}
+
+StructTop::~StructTop()
+{
+    // storage is freed after we return
+    for(auto i=nmembers; i; i--) {
+        members[i-1u].~FieldStorage();
+    }
+}
+
 }} // namespace pvxs::impl
@@ -66,6 +66,41 @@ void to_wire(Buffer& buf, const FieldDesc* cur)
     }
 }
 
+void to_wire(Buffer& buf, const std::shared_ptr<const FieldDesc>& type, TypeCache& cache)
+{
+    if(!type || !cache.limit) {
+        to_wire(buf, type.get());
+        return;
+    }
+
+    auto it = cache.index.find(type.get());
+    if(it!=cache.index.end()) {
+        // fetch cache
+        to_wire(buf, uint8_t(0xfe));
+        to_wire(buf, it->second);
+        return;
+    }
+
+    uint16_t key;
+    if(cache.slots.size() < cache.limit) {
+        key = uint16_t(cache.slots.size());
+        cache.slots.push_back(type);
+
+    } else {
+        // full.  replace oldest.  Peer overwrites its entry for this key.
+        key = uint16_t(cache.next);
+        cache.next = (cache.next+1u) % cache.limit;
+        cache.index.erase(cache.slots[key].get());
+        cache.slots[key] = type;
+    }
+    cache.index[type.get()] = key;
+
+    // update cache
+    to_wire(buf, uint8_t(0xfd));
+    to_wire(buf, key);
+    to_wire(buf, type.get());
+}
+
 void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, unsigned depth)
 {
     if(!buf.good() || depth>20) {
@@ -180,16 +215,18 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
 
                 // update field refs.
                 fld.miter.emplace_back(name, cindex-cref);
-                fld.mlookup[name] = cindex-cref;
+                fld.mlookup.add(name, cindex-cref);
                 name+='.';
 
                 if(code.code==TypeCode::Struct && code==cfld.code) {
                     // copy descendant indices for sub-struct
                     for(auto& pair : cfld.mlookup) {
-                        fld.mlookup[name+pair.first] = cindex - cref + pair.second;
+                        fld.mlookup.add(name+pair.first, cindex - cref + pair.second);
                     }
                 }
             }
+
+            descs[index].mlookup.sort();
         }
             break;
         default:
@@ -218,10 +255,71 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
     }
 }
 
-// serialize a field and all children (if Compound)
+namespace {
+// column element encoding.  Bool as uint8_t
+inline void to_wire_elem(Buffer& buf, bool val) { to_wire(buf, uint8_t(val)); }
+template<typename T>
+inline void to_wire_elem(Buffer& buf, const T& val) { to_wire(buf, val); }
+
+inline void from_wire_elem(Buffer& buf, bool& val) { uint8_t v=0u; from_wire(buf, v); val = v!=0u; }
+template<typename T>
+inline void from_wire_elem(Buffer& buf, T& val) { from_wire(buf, val); }
+
+struct Column {
+    TypeCode code;
+    size_t index; // in columns Value
+    void* base;
+};
+
+// leaf arrays of a columns Value
+std::vector<Column> columnsOf(const Value& cols)
+{
+    std::vector<Column> ret;
+    auto cdesc = Value::Helper::desc(cols);
+    auto cstore = Value::Helper::store_ptr(cols);
+    for(auto i : range(cdesc->size())) {
+        if(cstore[i].code==StoreType::Array)
+            ret.push_back(Column{cdesc[i].code.scalarOf(), i,
+                                 const_cast<void*>(cstore[i].as<shared_array<const void>>().data())});
+    }
+    return ret;
+}
+
+// Struct[] stored column-wise.  Same encoding as element-wise
+void to_wire_columns(Buffer& buf, const FieldStorage* store)
+{
+    auto& cols = store->as<Value>();
+    auto n = columnsLength(cols);
+    auto columns(columnsOf(cols));
+
+    to_wire(buf, Size{n});
+    for(auto r : range(n)) {
+        to_wire(buf, uint8_t(1u)); // never null
+        for(auto& col : columns) {
+            switch(col.code.code) {
+#define CASE(CODE, TYPE, STORE) \
+            case TypeCode::CODE: to_wire_elem(buf, static_cast<const TYPE*>(col.base)[r]); break;
+            COLUMN_TYPES(CASE)
+#undef CASE
+            default:
+                buf.fault(__FILE__, __LINE__);
+                return;
+            }
+        }
+    }
+}
+} // namespace
+
+// serialize a field and all children (if Compound).
+// Caller must hold a reference to the enclosing Value.
 static
-void to_wire_field(Buffer& buf, const FieldDesc* desc, const std::shared_ptr<const FieldStorage>& store)
+void to_wire_field(Buffer& buf, const FieldDesc* desc, const FieldStorage* store)
 {
+    if(desc->code==TypeCode::StructA && store->code==StoreType::Compound) {
+        to_wire_columns(buf, store);
+        return;
+    }
+
     switch(store->code) {
     case StoreType::Null:
         switch(desc->code.code) {
@@ -231,8 +329,7 @@ void to_wire_field(Buffer& buf, const FieldDesc* desc, const std::shared_ptr<con
                 auto cdesc = desc + off;
                 if(cdesc->code==TypeCode::Struct) // skip sub-struct nodes.  Would be redundant
                     continue;
-                std::shared_ptr<const FieldStorage> cstore(store, store.get()+off); // TODO avoid shared_ptr/aliasing here
-                to_wire_field(buf, cdesc, cstore);
+                to_wire_field(buf, cdesc, store+off);
             }
         }
             return;
@@ -417,20 +514,20 @@ void to_wire_full(Buffer& buf, const Value& val)
 {
     assert(!!val);
 
-    to_wire_field(buf, Value::Helper::desc(val), Value::Helper::store(val));
+    to_wire_field(buf, Value::Helper::desc(val), Value::Helper::store_ptr(val));
 }
 
 void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask)
 {
     auto desc = Value::Helper::desc(val);
-    auto store = Value::Helper::store(val);
+    auto store = Value::Helper::store_ptr(val);
     assert(desc && desc->code==TypeCode::Struct);
     assert(!mask || mask->size()==desc->size());
 
     BitMask valid(desc->size());
 
     for(size_t bit=0u, N=desc->size(); bit<N;) {
-        if(store.get()[bit].valid && (!mask || (*mask)[bit])) {
+        if(store[bit].valid && (!mask || (*mask)[bit])) {
             valid[bit] = true;
             bit += desc[bit].size(); // maybe skip past entire sub-struct
         } else {
@@ -441,8 +538,7 @@ void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask)
     to_wire(buf, valid);
 
     for(auto bit : valid.onlySet()) {
-        std::shared_ptr<const FieldStorage> cstore(store, store.get()+bit);
-        to_wire_field(buf, desc+bit, cstore);
+        to_wire_field(buf, desc+bit, store+bit);
     }
 }
 
@@ -457,8 +553,101 @@ T from_wire_as(Buffer& buf)
 }
 
 static
-void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store)
+void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, FieldStorage* store,
+                     const std::shared_ptr<FieldStorage>& owner);
+
+// deserialize Struct[] elements [begin, arr.size())
+static
+void from_wire_elements(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, FieldStorage* store,
+                        const std::shared_ptr<FieldStorage>& owner, shared_array<Value>& arr, size_t begin)
+{
+    std::shared_ptr<const FieldDesc> etype(store->top()->desc,
+                                           &desc->members[0]); // alias
+    std::shared_ptr<FieldStorage> enclosing(owner, store);
+    for(auto i : range(begin, arr.size())) {
+        if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
+            arr[i] = Value::Helper::build(etype, enclosing, desc);
+
+            from_wire_full(buf, ctxt, arr[i]);
+        }
+        if(!buf.good())
+            return;
+    }
+}
+
+// deserialize Struct[] of suitable type column-wise.  cf. FieldDesc::columns
+// Only when the field is already stored column-wise, otherwise element-wise as usual.
+static
+void from_wire_columns(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, FieldStorage* store,
+                       const std::shared_ptr<FieldStorage>& owner)
 {
+    Size alen{};
+    from_wire(buf, alen);
+    if(!buf.good())
+        return;
+    const auto n = alen.size;
+
+    auto cols(Value::Helper::build(desc->columns));
+    auto cstore = Value::Helper::store_ptr(cols);
+    auto columns(columnsOf(cols));
+    std::vector<shared_array<void>> arrs;
+    arrs.reserve(columns.size());
+    for(auto& col : columns) {
+        arrs.push_back(allocArray(col.code.arrayOf().arrayType(), n));
+        col.base = arrs.back().data();
+    }
+
+    size_t r;
+    for(r=0u; r<n && buf.good(); r++) {
+        if(from_wire_as<uint8_t>(buf)==0u)
+            break; // null element.  Not representable column-wise
+
+        for(auto& col : columns) {
+            switch(col.code.code) {
+#define CASE(CODE, TYPE, STORE) \
+            case TypeCode::CODE: from_wire_elem(buf, static_cast<TYPE*>(col.base)[r]); break;
+            COLUMN_TYPES(CASE)
+#undef CASE
+            default:
+                buf.fault(__FILE__, __LINE__);
+                return;
+            }
+        }
+    }
+    if(!buf.good())
+        return;
+
+    for(auto i : range(columns.size())) {
+        auto& fld = cstore[columns[i].index];
+        fld.as<shared_array<const void>>() = arrs[i].freeze();
+        fld.valid = true;
+    }
+
+    store->as<Value>() = std::move(cols);
+
+    if(r<n) {
+        // found a null element.  Switch to element-wise for r and after.
+        shared_array<Value> arr(n);
+        columnsToRows(arr, r, desc, std::shared_ptr<FieldStorage>(owner, store));
+        from_wire_elements(buf, ctxt, desc, store, owner, arr, r+1u);
+
+        store->deinit();
+        store->init(StoreType::Array);
+        store->as<shared_array<const void>>() = arr.freeze().castTo<const void>();
+    }
+}
+
+// deserialize a field and all children (if Compound).
+// 'owner' is a reference to the StructTop of 'store', used only when creating enclosed Values.
+static
+void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, FieldStorage* store,
+                     const std::shared_ptr<FieldStorage>& owner)
+{
+    if(desc->code==TypeCode::StructA && desc->columns && store->code==StoreType::Compound) {
+        from_wire_columns(buf, ctxt, desc, store, owner);
+        return;
+    }
+
     switch(store->code) {
     case StoreType::Null:
         switch(desc->code.code) {
@@ -466,9 +655,9 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             // serialize entire sub-structure
             for(auto off : range(desc->size())) {
                 auto cdesc = desc + off;
-                std::shared_ptr<FieldStorage> cstore(store, store.get()+off); // TODO avoid shared_ptr/aliasing here
+                auto cstore = store + off;
                 if(cdesc->code!=TypeCode::Struct) {
-                    from_wire_field(buf, ctxt, cdesc, cstore);
+                    from_wire_field(buf, ctxt, cdesc, cstore, owner);
                     cstore->valid = true;
                 }
             }
@@ -500,10 +689,10 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
     case StoreType::UInteger: {
         auto& fld = store->as<uint64_t>();
         switch(desc->code.code) {
-        case TypeCode::UInt8:  fld = from_wire_as<int8_t>(buf); return;
-        case TypeCode::UInt16: fld = from_wire_as<int16_t>(buf); return;
-        case TypeCode::UInt32: fld = from_wire_as<int32_t>(buf); return;
-        case TypeCode::UInt64: fld = from_wire_as<int64_t>(buf); return;
+        case TypeCode::UInt8:  fld = from_wire_as<uint8_t>(buf); return;
+        case TypeCode::UInt16: fld = from_wire_as<uint16_t>(buf); return;
+        case TypeCode::UInt32: fld = from_wire_as<uint32_t>(buf); return;
+        case TypeCode::UInt64: fld = from_wire_as<uint64_t>(buf); return;
         default: break;
         }
     }
@@ -535,9 +724,9 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
                 return;
 
             } else if(select.size < desc->miter.size()) {
-                std::shared_ptr<const FieldDesc> stype(store->top->desc,
+                std::shared_ptr<const FieldDesc> stype(store->top()->desc,
                                                        &desc->members[desc->miter[select.size].second]); // alias
-                fld = Value::Helper::build(stype, store, desc);
+                fld = Value::Helper::build(stype, std::shared_ptr<FieldStorage>(owner, store), desc);
 
                 from_wire_full(buf, ctxt, fld);
                 return;
@@ -546,19 +735,18 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             break;
 
         case TypeCode::Any: {
-            auto descs(std::make_shared<std::vector<FieldDesc>>());
+            std::vector<FieldDesc> descs;
 
-            from_wire(buf, *descs, ctxt);
+            from_wire(buf, descs, ctxt);
             if(!buf.good())
                 return;
 
-            if(descs->empty()) {
+            if(descs.empty()) {
                 fld = Value();
                 return;
 
             } else {
-                std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
-                fld = Value::Helper::build(stype);
+                fld = Value::Helper::build(intern(std::move(descs)));
 
                 from_wire_full(buf, ctxt, fld);
                 return;
@@ -614,15 +802,7 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
             Size alen{};
             from_wire(buf, alen);
             shared_array<Value> arr(alen.size);
-            std::shared_ptr<const FieldDesc> etype(store->top->desc,
-                                                   &desc->members[0]); // alias
-            for(auto& elem : arr) {
-                if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
-                    elem = Value::Helper::build(etype, store, desc);
-
-                    from_wire_full(buf, ctxt, elem);
-                }
-            }
+            from_wire_elements(buf, ctxt, desc, store, owner, arr, 0u);
 
             fld = arr.freeze().castTo<const void>();
         }
@@ -642,9 +822,9 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
                         // null element.  treated the same as 0 case (which is what actually happens)
 
                     } else if(select.size < cdesc->miter.size()) {
-                        std::shared_ptr<const FieldDesc> stype(store->top->desc,
+                        std::shared_ptr<const FieldDesc> stype(store->top()->desc,
                                                                &cdesc->members[cdesc->miter[select.size].second]); // alias
-                        elem = Value::Helper::build(stype, store, desc);
+                        elem = Value::Helper::build(stype, std::shared_ptr<FieldStorage>(owner, store), desc);
 
                         from_wire_full(buf, ctxt, elem);
 
@@ -666,16 +846,16 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
 
             for(auto& elem : arr) {
                 if(from_wire_as<uint8_t>(buf)!=0) { // strictly 1 or 0
-                    auto descs(std::make_shared<std::vector<FieldDesc>>());
+                    std::vector<FieldDesc> descs;
 
-                    from_wire(buf, *descs, ctxt);
+                    from_wire(buf, descs, ctxt);
                     if(!buf.good())
                         return;
 
-                    if(!descs->empty()) {
+                    if(!descs.empty()) {
 
-                        std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
-                        elem = Value::Helper::build(stype, store, desc);
+                        elem = Value::Helper::build(intern(std::move(descs)),
+                                                    std::shared_ptr<FieldStorage>(owner, store), desc);
 
                         from_wire_full(buf, ctxt, elem);
                     }
@@ -699,34 +879,36 @@ void from_wire_full(Buffer& buf, TypeStore& ctxt, Value& val)
 {
     assert(!!val);
 
-    from_wire_field(buf, ctxt, Value::Helper::desc(val), Value::Helper::store(val));
+    auto& owner = Value::Helper::store(val);
+    from_wire_field(buf, ctxt, Value::Helper::desc(val), owner.get(), owner);
 }
 
 void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val)
 {
     auto desc = Value::Helper::desc(val);
-    auto store = Value::Helper::store(val);
+    auto& owner = Value::Helper::store(val);
+    auto store = owner.get();
 
     if(!desc || !store) {
         buf.fault(__FILE__, __LINE__);
         return;
     }
 
-    auto top = store->top;
+    auto top = store->top();
 
     BitMask valid;
     from_wire(buf, valid);
     // encoding rounds # of bits to whole bytes, so we may trim
-    valid.resize(top->members.size());
+    valid.resize(top->nmembers);
     if(!buf.good())
         return;
 
     for(auto bit = valid.findSet(0u);
         bit<desc->size();)
     {
-        std::shared_ptr<FieldStorage> cstore(store, store.get()+bit);
+        auto cstore = store + bit;
         auto cdesc = desc + bit;
-        from_wire_field(buf, ctxt, cdesc, cstore);
+        from_wire_field(buf, ctxt, cdesc, cstore, owner);
         cstore->valid = true;
         bit = valid.findSet(bit + cdesc->size());
     }
@@ -734,16 +916,15 @@ void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val)
 
 void from_wire_type(Buffer& buf, TypeStore& ctxt, Value& val)
 {
-    auto descs(std::make_shared<std::vector<FieldDesc>>());
+    std::vector<FieldDesc> descs;
 
-    from_wire(buf, *descs, ctxt);
+    from_wire(buf, descs, ctxt);
     if(!buf.good())
         return;
 
-    if(!descs->empty()) {
+    if(!descs.empty()) {
 
-        std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
-        val = Value::Helper::build(stype);
+        val = Value::Helper::build(intern(std::move(descs)));
 
     } else {
         val = Value();
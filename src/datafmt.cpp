@@ -30,7 +30,7 @@ struct FmtDelta {
         if(fmt._showValue) {
             auto store = Value::Helper::store_ptr(val);
 
-            switch(val.storageType()) {
+            switch(store->code) {
             case StoreType::Real:     strm<<" = "<<store->as<double>(); break;
             case StoreType::Integer:  strm<<" = "<<store->as<int64_t>(); break;
             case StoreType::UInteger: strm<<" = "<<store->as<uint64_t>(); break;
@@ -141,6 +141,27 @@ struct FmtTree {
         if(!member.empty() && desc->code!=TypeCode::Struct)
             strm<<" "<<member;
 
+        if(desc->code==TypeCode::StructA && store->code==StoreType::Compound) {
+            // column-wise.  Show as elements
+            auto n = columnsLength(store->as<Value>());
+            if(!fmt._showValue) {
+                strm<<"\n";
+            } else {
+                shared_array<Value> arr(n);
+                std::shared_ptr<FieldStorage> temp(std::shared_ptr<FieldStorage>(), const_cast<FieldStorage*>(store));
+                columnsToRows(arr, n, desc, temp);
+                strm<<" [\n";
+                for(auto& val : arr) {
+                    Indented I(strm);
+                    top(std::string(),
+                        Value::Helper::desc(val),
+                        Value::Helper::store_ptr(val));
+                }
+                strm<<indent{}<<"]\n";
+            }
+            return;
+        }
+
         switch(store->code) {
         case StoreType::Null:
             if(desc->code==TypeCode::Struct) {
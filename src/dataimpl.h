@@ -8,6 +8,11 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+#include <epicsMutex.h>
 
 #include <pvxs/data.h>
 #include <pvxs/sharedArray.h>
@@ -42,6 +47,107 @@ struct Value::Helper {
 namespace impl {
 struct Buffer;
 
+/** Name to relative index mapping.  A sorted, contiguous, replacement for std::map
+ *
+ * Entries are add()'d in any order, then sort() must be called once before use.
+ * Iteration is in lexical order of name.
+ */
+struct FieldIndex {
+    typedef std::pair<std::string, size_t> value_type;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    inline void reserve(size_t n) { entries.reserve(n); }
+    inline void add(std::string&& name, size_t index) { entries.emplace_back(std::move(name), index); }
+    inline void add(const std::string& name, size_t index) { entries.emplace_back(name, index); }
+    //! Sort, and remove duplicates.  As with std::map::operator[], the last added wins.
+    void sort();
+
+    const_iterator find(const std::string& name) const {
+        auto it = std::lower_bound(entries.begin(), entries.end(), name,
+                                   [](const value_type& ent, const std::string& name) {
+                                       return ent.first < name;
+                                   });
+        return it!=entries.end() && it->first==name ? it : entries.end();
+    }
+
+    inline const_iterator begin() const { return entries.begin(); }
+    inline const_iterator end() const { return entries.end(); }
+    inline size_t size() const { return entries.size(); }
+    inline bool empty() const { return entries.empty(); }
+
+private:
+    std::vector<value_type> entries;
+};
+
+/* Retained allocations of StructTop for a single FieldDesc.
+ * cf. setValuePoolLimit()
+ *
+ * Reference counted by the owning FieldDesc, and by each outstanding allocation.
+ */
+struct StructPool {
+    static std::atomic<size_t> limit;
+    // cf. valuePoolStats()
+    static std::atomic<size_t> nhit, nmiss;
+
+    std::atomic<size_t> refs{1u};
+
+    epicsMutex lock;
+    // all of the same size
+    std::vector<void*> blocks;
+    size_t blockSize = 0u;
+
+    INST_COUNTER(StructPool);
+
+    StructPool() = default;
+    StructPool(const StructPool&) = delete;
+    StructPool& operator=(const StructPool&) = delete;
+    ~StructPool();
+
+    inline void ref() { refs.fetch_add(1u, std::memory_order_relaxed); }
+    inline void unref() {
+        if(refs.fetch_sub(1u, std::memory_order_acq_rel)==1u)
+            delete this;
+    }
+
+    // @returns a block of nbytes, or nullptr
+    void* pop(size_t nbytes);
+    // @returns true if block was retained
+    bool push(void* block, size_t nbytes);
+};
+
+// Lazily created StructPool.  Not copied along with a FieldDesc.
+struct StructPoolRef {
+    mutable std::atomic<StructPool*> pool{nullptr};
+
+    StructPoolRef() = default;
+    StructPoolRef(const StructPoolRef&) {}
+    StructPoolRef& operator=(const StructPoolRef&) { return *this; }
+    ~StructPoolRef() {
+        if(auto p = pool.load(std::memory_order_acquire))
+            p->unref();
+    }
+
+    // @returns borrowed reference, valid while the owning FieldDesc is.
+    StructPool* get() const;
+};
+
+// Member types which may appear in a Struct[] element type which is stored column-wise.
+// CASE(TypeCode, C++ type of column element, FieldStorage::as<>() type of member)
+#define COLUMN_TYPES(CASE) \
+    CASE(Bool,    bool,        bool) \
+    CASE(Int8,    int8_t,      int64_t) \
+    CASE(Int16,   int16_t,     int64_t) \
+    CASE(Int32,   int32_t,     int64_t) \
+    CASE(Int64,   int64_t,     int64_t) \
+    CASE(UInt8,   uint8_t,     uint64_t) \
+    CASE(UInt16,  uint16_t,    uint64_t) \
+    CASE(UInt32,  uint32_t,    uint64_t) \
+    CASE(UInt64,  uint64_t,    uint64_t) \
+    CASE(Float32, float,       double) \
+    CASE(Float64, double,      double) \
+    CASE(String,  std::string, std::string)
+
 /** Describes a single field, leaf or otherwise, in a nested structure.
  *
  * FieldDesc are always stored depth first as a contiguous array,
@@ -59,7 +165,7 @@ struct FieldDesc {
     // "fld.sub.leaf" -> rel index
     // For Struct, relative to this (always >=1)
     // For Union, offset in members array (one entry will always be zero)
-    std::map<std::string, size_t> mlookup;
+    FieldIndex mlookup;
 
     // child iteration.  child# -> ("sub", rel index in enclosing vector<FieldDesc>)
     std::vector<std::pair<std::string, size_t>> miter;
@@ -76,6 +182,12 @@ struct FieldDesc {
 
     TypeCode code{TypeCode::Null};
 
+    // recycled storage for Values of this type
+    StructPoolRef pool;
+
+    // For StructA, when elements may be stored column-wise.  cf. Value::columns()
+    std::shared_ptr<const FieldDesc> columns;
+
     // number of FieldDesc nodes which describe this node.  Inclusive.  always size()>=1
     inline size_t size() const { return 1u + (members.empty() ? mlookup.size() : 0u); }
 };
@@ -83,8 +195,42 @@ struct FieldDesc {
 PVXS_API
 void to_wire(Buffer& buf, const FieldDesc* cur);
 
+/** Return the process-wide shared instance of a newly built type description.
+ *
+ * Identical (including IDs) descriptions are hash-consed, so that equal types
+ * are usually represented by the same FieldDesc, making Value::equalType() a pointer compare.
+ * Returns nullptr if descs is empty.
+ */
+PVXS_API
+std::shared_ptr<const FieldDesc> intern(std::vector<FieldDesc>&& descs);
+
+//! Number of distinct type descriptions currently interned.  For tests.
+PVXS_API
+size_t internedCount();
+
 typedef std::map<uint16_t, std::vector<FieldDesc>> TypeStore;
 
+/* Sender side of the introspection cache (cf. TypeStore).
+ * Remembers which type descriptions have been sent to a peer,
+ * so that repeats can be sent as a short reference (0xfe) to a cache key.
+ * Holds a reference to each cached description, so FieldDesc* keys stay valid.
+ * Relies on the peer decoding every type description it is sent.
+ */
+struct TypeCache {
+    // maximum number of cache keys to use.  Zero disables.  When full, keys are reused round-robin.
+    size_t limit;
+
+    std::unordered_map<const FieldDesc*, uint16_t> index;
+    std::vector<std::shared_ptr<const FieldDesc>> slots; // indexed by cache key
+    size_t next = 0u;
+
+    explicit TypeCache(size_t limit=0u) :limit(std::min(limit, size_t(0x7fff))) {}
+};
+
+//! Encode type description, using and updating the sender's cache.
+PVXS_API
+void to_wire(Buffer& buf, const std::shared_ptr<const FieldDesc>& type, TypeCache& cache);
+
 PVXS_API
 void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, unsigned depth=0);
 
@@ -108,7 +254,7 @@ struct FieldStorage {
                        shared_array<const void> // array of POD, std::string, or std::shared_ptr<Value>
     >::type store;
     // index of this field in StructTop::members
-    StructTop *top;
+    uint32_t idx;
     bool valid=false;
     StoreType code=StoreType::Null;
 
@@ -116,7 +262,8 @@ struct FieldStorage {
     void deinit();
     ~FieldStorage();
 
-    size_t index() const;
+    inline size_t index() const { return idx; }
+    inline StructTop* top() const;
 
     template<typename T>
     T& as() { return *reinterpret_cast<T*>(&store); }
@@ -127,22 +274,78 @@ struct FieldStorage {
     inline const uint8_t* buffer() const { return reinterpret_cast<const uint8_t*>(&store); }
 };
 
+/* Previously serialized (by to_wire_valid()) forms of a StructTop,
+ * which is no longer being modified.
+ * Allows one monitor update to be encoded once for many subscribers.
+ */
+struct WireCache {
+    struct Entry {
+        const FieldDesc* desc;
+        BitMask mask;
+        bool be;
+        // UInt8.  Immutable once added, so may be referenced after lock is released.
+        shared_array<const void> bytes;
+    };
+    epicsMutex lock;
+    std::vector<Entry> entries;
+};
+
 // hidden (publicly) management of an allocated Struct
 struct StructTop {
     // type of first top level struct.  always !NULL.
     // Actually the first element of a vector<const FieldDesc>
     std::shared_ptr<const FieldDesc> desc;
-    // our members (inclusive).  always size()>=1
-    std::vector<FieldStorage> members;
+    // our members (inclusive).  Allocated in the same block as this StructTop,
+    // and preceded by a back pointer used by FieldStorage::top()
+    FieldStorage* members = nullptr;
+    // always >=1
+    size_t nmembers = 0u;
 
     // empty, or the field of a structure which encloses this.
     std::weak_ptr<FieldStorage> enclosing;
 
+    // lazily created.  Access only with std::atomic_load() and friends.
+    std::shared_ptr<WireCache> wirecache;
+
     INST_COUNTER(StructTop);
+
+    // Allocate, with un-initialized (FieldStorage::init() not called) members, in a single allocation
+    static
+    std::shared_ptr<StructTop> create(const std::shared_ptr<const FieldDesc>& desc);
+
+    StructTop() = default;
+    StructTop(const StructTop&) = delete;
+    StructTop& operator=(const StructTop&) = delete;
+    ~StructTop();
 };
 
+StructTop* FieldStorage::top() const
+{
+    return reinterpret_cast<StructTop* const*>(this - idx)[-1];
+}
+
 using Type = std::shared_ptr<const FieldDesc>;
 
+/* Struct[] stored column-wise.  cf. Value::columns()
+ *
+ * FieldStorage::code is StoreType::Compound, instead of StoreType::Array,
+ * holding a Struct Value of type FieldDesc::columns.  Each leaf of which is an array
+ * with one entry per element.
+ */
+
+//! Number of elements in column-wise Struct[] storage
+size_t columnsLength(const Value& cols);
+
+//! Create element r of the column-wise StructA field desc/store.
+Value columnsToRow(const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store, size_t r);
+
+//! Fill rows[0, n) from the first n elements of the column-wise StructA field desc/store.
+void columnsToRows(shared_array<Value>& rows, size_t n,
+                   const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store);
+
+//! Switch the column-wise StructA field desc/store to element-wise storage.  Content is unchanged.
+void columnsToElements(const FieldDesc* desc, const std::shared_ptr<FieldStorage>& store);
+
 
 //! serialize all Value fields
 PVXS_API
@@ -178,7 +381,7 @@ Value Value::Helper::build(const std::shared_ptr<const impl::FieldDesc>& desc,
                            const std::shared_ptr<impl::FieldStorage>& pstore, const impl::FieldDesc* pdesc)
 {
     Value ret(desc);
-    auto& enc = ret.store->top->enclosing;
+    auto& enc = ret.store->top()->enclosing;
     enc = pstore;
     return ret;
 }
@@ -13,7 +13,7 @@
 
 #include <cstring>
 #include <system_error>
-#include <deque>
+#include <atomic>
 #include <algorithm>
 
 #include <event2/event.h>
@@ -24,8 +24,6 @@
 #include <epicsEvent.h>
 #include <epicsThread.h>
 #include <epicsExit.h>
-#include <epicsMutex.h>
-#include <epicsGuard.h>
 #include <dbDefs.h>
 #include <ellLib.h>
 
@@ -34,12 +32,21 @@
 #include "utilpvt.h"
 #include <pvxs/log.h>
 
-typedef epicsGuard<epicsMutex> Guard;
-
 // EvInBuf prefers to extract slices of this length from a backing buffer
 static constexpr
 size_t min_slice_size = 1024u;
 
+// EvOutBuf appends arrays of at least this many bytes by reference
+static constexpr
+size_t min_ref_size = 4096u;
+
+// SegCollector chain size limits.
+// Above ~32MB, glibc always returns free()'d blocks to the OS.
+static constexpr
+size_t min_seg_chain = 64u*1024u;
+static constexpr
+size_t max_seg_chain = 16u*1024u*1024u;
+
 namespace pvxs {namespace impl {
 
 DEFINE_LOGGER(logerr, "pvxs.loop");
@@ -47,6 +54,12 @@ DEFINE_LOGGER(logtimer, "pvxs.timer");
 
 namespace mdetail {
 VFunctor0::~VFunctor0() {}
+std::atomic<size_t> heapCount{0u};
+}
+
+size_t mfunctionHeapCount()
+{
+    return mdetail::heapCount.load(std::memory_order_relaxed);
 }
 
 static
@@ -113,23 +126,81 @@ struct evbase::Pvt : public epicsThreadRunable
     std::weak_ptr<Pvt> internal_self;
 
     struct Work {
+        std::atomic<Work*> next{nullptr};
         mfunction fn;
-        std::exception_ptr *result;
-        epicsEvent *notify;
+        std::exception_ptr *result = nullptr;
+        epicsEvent *notify = nullptr;
+        Work() = default;
         Work(mfunction&& fn, std::exception_ptr *result, epicsEvent *notify)
             :fn(std::move(fn)), result(result), notify(notify)
         {}
     };
-    std::deque<Work> actions;
+
+    /* Intrusive, unbounded, multi-producer single-consumer queue.
+     * cf. Dmitry Vyukov's "Intrusive MPSC node-based queue".
+     *
+     * push() from any thread is wait-free (one atomic exchange).
+     * pop() only from the worker, or after the worker has exited.
+     * pop() may return nullptr while a concurrent push() is half complete.
+     * This is safe as such a producer will always wakeup the worker afterwards.
+     */
+    struct WorkQueue {
+        std::atomic<Work*> head;
+        Work* tail;
+        Work stub;
+
+        WorkQueue() :head(&stub), tail(&stub) {}
+        WorkQueue(const WorkQueue&) = delete;
+        WorkQueue& operator=(const WorkQueue&) = delete;
+        ~WorkQueue() {
+            while(auto work = pop())
+                delete work;
+        }
+
+        void push(Work* work) {
+            work->next.store(nullptr, std::memory_order_relaxed);
+            auto prev = head.exchange(work, std::memory_order_acq_rel);
+            prev->next.store(work, std::memory_order_release);
+        }
+
+        Work* pop() {
+            auto cur = tail;
+            auto next = cur->next.load(std::memory_order_acquire);
+            if(cur==&stub) {
+                if(!next)
+                    return nullptr; // empty
+                tail = cur = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if(next) {
+                tail = next;
+                return cur;
+            }
+            if(cur!=head.load(std::memory_order_acquire))
+                return nullptr; // push() in progress
+            // cur is the last entry.  re-insert stub so that cur can be removed.
+            push(&stub);
+            next = cur->next.load(std::memory_order_acquire);
+            if(next) {
+                tail = next;
+                return cur;
+            }
+            return nullptr; // push() in progress
+        }
+    };
+    WorkQueue actions;
+    // set when dowork has been activated, and cleared by the worker before draining actions.
+    std::atomic<bool> wakeup{false};
+    // number of threads between testing 'running' and completing a push()
+    std::atomic<size_t> producers{0u};
 
     owned_ptr<event_base> base;
     evevent keepalive;
     evevent dowork;
     epicsEvent start_sync;
-    epicsMutex lock;
 
     epicsThread worker;
-    bool running = true;
+    std::atomic<bool> running{true};
 
     INST_COUNTER(evbase);
 
@@ -151,15 +222,43 @@ struct evbase::Pvt : public epicsThreadRunable
 
     void join()
     {
-        {
-            Guard G(lock);
-            running = false;
-        }
+        running = false;
         if(worker.isCurrentThread())
             log_crit_printf(logerr, "evbase self-joining: %s\n", worker.getNameSelf());
         if(event_base_loopexit(base.get(), nullptr))
             log_crit_printf(logerr, "evbase error while interrupting loop for %p\n", base.get());
         worker.exitWait();
+
+        // wait for any producer which saw running==true to complete its push()
+        while(producers.load())
+            epicsThreadSleep(0.0);
+
+        // fail any work which was queued too late to be executed
+        while(auto work = actions.pop()) {
+            std::unique_ptr<Work> trash(work);
+            if(work->result)
+                *work->result = std::make_exception_ptr(std::logic_error("Worker stopped"));
+            if(work->notify)
+                work->notify->signal();
+        }
+    }
+
+    // returns false if worker is stopped
+    bool enqueue(std::unique_ptr<Work>&& work)
+    {
+        producers++;
+        if(!running.load()) {
+            producers--;
+            return false;
+        }
+        actions.push(work.release());
+
+        // only the first producer after the worker begins draining needs to wake it up.
+        if(!wakeup.exchange(true))
+            event_active(dowork.get(), EV_TIMEOUT, 0);
+
+        producers--;
+        return true;
     }
 
     virtual void run() override final
@@ -179,6 +278,9 @@ struct evbase::Pvt : public epicsThreadRunable
             if(evthread_make_base_notifiable(tbase.get())) {
                 throw std::runtime_error("evthread_make_base_notifiable");
             }
+            if(event_base_priority_init(tbase.get(), evbase_priorities)) {
+                throw std::runtime_error("event_base_priority_init");
+            }
 
             evevent handle(event_new(tbase.get(), -1, EV_TIMEOUT, &doWorkS, this));
             evevent ka(event_new(tbase.get(), -1, EV_TIMEOUT|EV_PERSIST, &evkeepalive, this));
@@ -209,28 +311,36 @@ struct evbase::Pvt : public epicsThreadRunable
 
     void doWork()
     {
-        decltype (actions) todo;
-        {
-            Guard G(lock);
-            todo = std::move(actions);
-        }
-        for(auto& work : todo) {
+        // clear before draining so that any push() not seen below will wake us again
+        wakeup = false;
+
+        // bound the number of actions executed before returning to the loop
+        // so that a busy producer can't starve socket I/O.
+        size_t nwork = 0u;
+        for(; nwork < max_batch; nwork++) {
+            std::unique_ptr<Work> work(actions.pop());
+            if(!work)
+                break;
+
             try {
-                auto fn(std::move(work.fn));
+                auto fn(std::move(work->fn));
                 fn();
             }catch(std::exception& e){
-                if(work.result) {
-                    Guard G(lock);
-                    *work.result = std::current_exception();
+                if(work->result) {
+                    *work->result = std::current_exception();
                 } else {
                     log_exc_printf(logerr, "Unhandled exception in event_base : %s : %s\n",
                                     typeid(e).name(), e.what());
                 }
             }
-            if(work.notify)
-                work.notify->signal();
+            if(work->notify)
+                work->notify->signal();
         }
+
+        if(nwork==max_batch && !wakeup.exchange(true))
+            event_active(dowork.get(), EV_TIMEOUT, 0); // there may be more
     }
+    static constexpr size_t max_batch = 1024u;
     static
     void doWorkS(evutil_socket_t sock, short evt, void *raw)
     {
@@ -286,21 +396,13 @@ void evbase::sync() const
 
 bool evbase::_dispatch(mfunction&& fn, bool dothrow) const
 {
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        if(!pvt->running) {
-            if(dothrow)
-                throw std::logic_error("Worker stopped");
-            return false;
-        }
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), nullptr, nullptr);
-    }
+    std::unique_ptr<Pvt::Work> work(new Pvt::Work(std::move(fn), nullptr, nullptr));
 
-    timeval now{};
-    if(empty && event_add(pvt->dowork.get(), &now))
-        throw std::runtime_error("Unable to wakeup dispatch()");
+    if(!pvt->enqueue(std::move(work))) {
+        if(dothrow)
+            throw std::logic_error("Worker stopped");
+        return false;
+    }
 
     return true;
 }
@@ -315,24 +417,16 @@ bool evbase::_call(mfunction&& fn, bool dothrow) const
     static ThreadEvent done;
 
     std::exception_ptr result;
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        if(!pvt->running) {
-            if(dothrow)
-                throw std::logic_error("Worker stopped");
-            return false;
-        }
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), &result, done.get());
-    }
+    std::unique_ptr<Pvt::Work> work(new Pvt::Work(std::move(fn), &result, done.get()));
 
-    timeval now{};
-    if(empty && event_add(pvt->dowork.get(), &now))
-        throw std::runtime_error("Unable to wakeup call()");
+    if(!pvt->enqueue(std::move(work))) {
+        if(dothrow)
+            throw std::logic_error("Worker stopped");
+        return false;
+    }
 
+    // signal() of done orders the worker's write of result before our read
     done->wait();
-    Guard G(pvt->lock);
     if(result)
         std::rethrow_exception(result);
     return true;
@@ -353,7 +447,6 @@ bool evbase::assertInRunningLoop() const
     if(pvt->worker.isCurrentThread())
         return true;
 
-    Guard G(pvt->lock);
     if(!pvt->running)
         return false;
 
@@ -563,6 +656,51 @@ void from_wire(Buffer &buf, SockAddr& val)
 
 bool Buffer::refill(size_t more) { return false; }
 
+bool Buffer::addRef(const shared_array<const void>& arr, size_t nbytes) { return false; }
+
+std::shared_ptr<const void> Buffer::takeRef(size_t nbytes, size_t align) { return nullptr; }
+
+bool BoundedPriority::set(int level)
+{
+    this->level = level;
+    burst = 0u;
+    return bev && bufferevent_priority_set(bev.get(), level)==0;
+}
+
+void BoundedPriority::tick()
+{
+    if(level>=evbase_default_priority || !bev)
+        return; // not above the default level
+
+    if(!probe) {
+        probe = evevent(event_new(bufferevent_get_base(bev.get()), -1, EV_TIMEOUT, &probeS, this));
+        if(event_priority_set(probe.get(), evbase_default_priority))
+            throw std::logic_error("Unable to set probe priority");
+    }
+
+    if(burst++==0u) {
+        // notify when the loop next reaches the default level
+        event_active(probe.get(), EV_TIMEOUT, 0);
+    }
+
+    if(burst==burst_limit) {
+        // move to the default level until probe runs.
+        if(bufferevent_priority_set(bev.get(), evbase_default_priority)==0)
+            ndemote++;
+        else
+            burst--; // an event of bev is active.  Retry on the next tick.
+    }
+}
+
+void BoundedPriority::probeS(evutil_socket_t sock, short evt, void *raw)
+{
+    auto self = static_cast<BoundedPriority*>(raw);
+    // the default level has been serviced.  Restore.
+    self->burst = 0u;
+    if(self->bev)
+        (void)bufferevent_priority_set(self->bev.get(), self->level);
+}
+
 FixedBuf::~FixedBuf() {}
 
 VectorOutBuf::~VectorOutBuf() {}
@@ -612,6 +750,28 @@ bool EvOutBuf::refill(size_t more)
     return true;
 }
 
+static
+void releaseRef(const void *data, size_t datalen, void *extra)
+{
+    delete static_cast<shared_array<const void>*>(extra);
+}
+
+bool EvOutBuf::addRef(const shared_array<const void>& arr, size_t nbytes)
+{
+    // below this, copying is cheaper than the extra evbuffer chain
+    if(err || nbytes < min_ref_size)
+        return false;
+
+    refill(0); // commit anything already written
+
+    std::unique_ptr<shared_array<const void>> ref(new shared_array<const void>(arr));
+    if(evbuffer_add_reference(backing, arr.data(), nbytes, &releaseRef, ref.get()))
+        throw std::bad_alloc();
+    ref.release(); // now owned by backing
+
+    return true;
+}
+
 EvInBuf::~EvInBuf() { refill(0); }
 
 bool EvInBuf::refill(size_t needed)
@@ -656,6 +816,67 @@ bool EvInBuf::refill(size_t needed)
     return true;
 }
 
+std::shared_ptr<const void> EvInBuf::takeRef(size_t nbytes, size_t align)
+{
+    if(err || nbytes < min_ref_size || nbytes > evbuffer_get_length(backing))
+        return nullptr;
+
+    refill(0); // drain anything already consumed
+
+    evbuffer_iovec vec;
+    if(evbuffer_peek(backing, -1, nullptr, &vec, 1)<=0 || vec.iov_len < nbytes
+            || size_t(vec.iov_base)%align)
+        return nullptr; // not contiguous or not aligned
+
+    // bytes after nbytes in this segment which must be copied back
+    auto tail = vec.iov_len - nbytes;
+    if(tail > nbytes)
+        return nullptr; // cheaper to copy the array
+
+    // Move the first segment into a private buffer, which is kept alive with the array.
+    // When a complete segment is removed, libevent moves it without copying.
+    std::shared_ptr<evbuffer> pinned(evbuffer_new(), evbuffer_free);
+    if(!pinned)
+        throw std::bad_alloc();
+    if(evbuffer_remove_buffer(backing, pinned.get(), vec.iov_len)!=int(vec.iov_len))
+        throw std::bad_alloc();
+
+    auto start = evbuffer_pullup(pinned.get(), -1); // only one segment, so no copy
+    if(tail && evbuffer_prepend(backing, start + nbytes, tail))
+        throw std::bad_alloc();
+
+    return std::shared_ptr<const void>(pinned, start);
+}
+
+void SegCollector::append(evbuffer *dest, evbuffer *src, size_t len)
+{
+    while(len) {
+        if(!room) {
+            // grow geometrically with the message
+            room = std::min(std::max(std::max(total, len), min_seg_chain), max_seg_chain);
+            if(evbuffer_expand(dest, room))
+                throw std::bad_alloc();
+        }
+
+        auto n = std::min(len, room);
+        evbuffer_iovec vec;
+        if(evbuffer_reserve_space(dest, n, &vec, 1)!=1)
+            throw std::bad_alloc();
+
+        auto ret = evbuffer_remove(src, vec.iov_base, n);
+        if(ret<0 || size_t(ret)!=n)
+            throw std::logic_error("SegCollector source underflow");
+
+        vec.iov_len = n;
+        if(evbuffer_commit_space(dest, &vec, 1))
+            throw std::bad_alloc();
+
+        room -= n;
+        total += n;
+        len -= n;
+    }
+}
+
 void to_evbuf(evbuffer *buf, const Header& H, bool be)
 {
     EvOutBuf M(be, buf, 8);
@@ -11,6 +11,9 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <new>
+#include <type_traits>
+#include <cstddef>
 
 #include <event2/event.h>
 #include <event2/buffer.h>
@@ -81,42 +84,128 @@ struct owned_ptr : public std::unique_ptr<T>
  * std::function<void()> fn(std::move(lambda));
  *
  * So we invent our own limited, non-copyable, version of std::function<void()>.
+ *
+ * Small functors (eg. a lambda capturing a couple of shared_ptr<>) are stored inline,
+ * avoiding an allocation for each evbase::dispatch() or call().  Larger functors,
+ * or those which may throw when moved, fall back to the heap.
+ * The number of these outstanding is tracked by the "mfunctionAlloc" instance counter,
+ * and the total number ever allocated is returned by mfunctionHeapCount().
  */
 namespace mdetail {
 struct PVXS_API VFunctor0 {
     virtual ~VFunctor0() =0;
     virtual void invoke() =0;
+    // move construct into inline storage of another mfunction
+    virtual VFunctor0* moveTo(void* storage) noexcept =0;
 };
 template<typename Fn>
 struct Functor0 : public VFunctor0 {
-    Functor0() = default;
     Functor0(const Functor0&) = delete;
-    Functor0(Functor0&&) = default;
-    Functor0(Fn&& fn) : fn(std::move(fn)) {}
+    explicit Functor0(Fn&& fn) : fn(std::move(fn)) {}
     virtual ~Functor0() {}
 
     void invoke() override final { fn(); }
+    VFunctor0* moveTo(void* storage) noexcept override final {
+        return new (storage) Functor0(std::move(fn));
+    }
 private:
     Fn fn;
 };
+template<typename Fn>
+struct HeapFunctor0 final : public Functor0<Fn> {
+    explicit HeapFunctor0(Fn&& fn) : Functor0<Fn>(std::move(fn)) {}
+    INST_COUNTER(mfunctionAlloc);
+};
+// cf. mfunctionHeapCount()
+PVXS_API extern std::atomic<size_t> heapCount;
 } // namespace detail
 
+//! Total number of mfunction heap allocations.  Never decreases.
+PVXS_API
+size_t mfunctionHeapCount();
+
 struct mfunction {
     mfunction() = default;
-    template<typename Fn>
+    template<typename Fn,
+             typename = typename std::enable_if<!std::is_same<typename std::decay<Fn>::type, mfunction>::value>::type>
     mfunction(Fn&& fn)
-        :fn{new mdetail::Functor0<Fn>(std::move(fn))}
-    {}
+    {
+        typedef typename std::decay<Fn>::type fn_t;
+        construct<fn_t>(std::move(fn), std::integral_constant<bool, fitsInline<fn_t>()>{});
+    }
+    mfunction(const mfunction&) = delete;
+    mfunction(mfunction&& o) noexcept { take(o); }
+    mfunction& operator=(const mfunction&) = delete;
+    mfunction& operator=(mfunction&& o) noexcept {
+        if(this!=&o) {
+            clear();
+            take(o);
+        }
+        return *this;
+    }
+    ~mfunction() { clear(); }
+
     void operator()() const {
         fn->invoke();
     }
     explicit operator bool() const {
-        return fn.operator bool();
+        return fn;
     }
 private:
-    std::unique_ptr<mdetail::VFunctor0> fn;
+    // enough for several pointers or shared_ptr<>s
+    static constexpr size_t inline_size = 6u*sizeof(void*);
+    typedef typename std::aligned_storage<inline_size, alignof(std::max_align_t)>::type storage_t;
+
+    template<typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(mdetail::Functor0<Fn>)<=sizeof(storage_t)
+                && alignof(mdetail::Functor0<Fn>)<=alignof(storage_t)
+                && std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template<typename Fn>
+    void construct(Fn&& fn, std::true_type) {
+        this->fn = new (&storage) mdetail::Functor0<Fn>(std::move(fn));
+        inplace = true;
+    }
+    template<typename Fn>
+    void construct(Fn&& fn, std::false_type) {
+        this->fn = new mdetail::HeapFunctor0<Fn>(std::move(fn));
+        mdetail::heapCount.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    void take(mfunction& o) noexcept {
+        if(o.inplace) {
+            fn = o.fn->moveTo(&storage);
+            inplace = true;
+            o.clear();
+        } else {
+            fn = o.fn;
+            o.fn = nullptr;
+        }
+    }
+    void clear() noexcept {
+        if(inplace)
+            fn->~VFunctor0();
+        else
+            delete fn;
+        fn = nullptr;
+        inplace = false;
+    }
+
+    mdetail::VFunctor0* fn = nullptr;
+    bool inplace = false;
+    storage_t storage;
 };
 
+// Number of libevent priority levels of each evbase.
+// Events default to level evbase_priorities/2 (3), which is also used by PVA connections
+// with priority 0.  Levels 0 through 2 are used by connections with priority 1 through 99,
+// in three bands with higher priority served first.  Levels 4 through 6 are not used.
+// cf. BoundedPriority
+constexpr int evbase_priorities = 7;
+constexpr int evbase_default_priority = evbase_priorities/2;
+
 struct PVXS_API evbase {
     evbase() = default;
     explicit evbase(const std::string& name, unsigned prio=0);
@@ -180,6 +269,38 @@ typedef owned_ptr<evconnlistener> evlisten;
 typedef owned_ptr<bufferevent> evbufferevent;
 typedef owned_ptr<evbuffer> evbuf;
 
+/* Strict priority for a bufferevent, bounded so that events at the default level,
+ * including the evbase work queue, timers, and priority 0 connections, are not starved.
+ *
+ * libevent only runs callbacks from the highest priority non-empty active queue
+ * in each loop iteration.  After burst_limit callbacks of a bufferevent above the default level,
+ * without the loop reaching the default level, the bufferevent is moved to the default level
+ * until it does.
+ */
+struct PVXS_API BoundedPriority {
+    static constexpr unsigned burst_limit = 16u;
+
+    explicit BoundedPriority(const evbufferevent& bev) :bev(bev) {}
+    BoundedPriority(const BoundedPriority&) = delete;
+    BoundedPriority& operator=(const BoundedPriority&) = delete;
+
+    // apply libevent priority level
+    bool set(int level);
+    // call from each read and write callback of bev
+    void tick();
+
+    // number of times moved to the default level
+    size_t ndemote = 0u;
+private:
+    const evbufferevent& bev;
+    int level = evbase_default_priority;
+    unsigned burst = 0u;
+    // at the default level.  Runs when the loop reaches that level.
+    evevent probe;
+
+    static void probeS(evutil_socket_t sock, short evt, void *raw);
+};
+
 PVXS_API
 void to_wire(Buffer& buf, const SockAddr& val);
 
@@ -7,11 +7,14 @@
 #  error Must define CASE
 #endif
 CASE(StructTop);
+CASE(StructPool);
+CASE(StructPoolFree);
 
 CASE(UDPListener);
 CASE(evbase);
 CASE(evbaseRunning);
 CASE(Timer);
+CASE(mfunctionAlloc);
 
 CASE(GPROp);
 CASE(Connection);
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <cstring>
 #include <vector>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <initializer_list>
@@ -23,6 +24,7 @@
 #include <pvxs/version.h>
 #include <pvxs/sharedArray.h>
 #include "utilpvt.h"
+#include "arrayops.h"
 
 namespace pvxs {namespace impl {
 
@@ -44,6 +46,15 @@ protected:
 
     virtual bool refill(size_t more);
 
+public:
+    // Append nbytes from the start of arr without copying, if supported.
+    // When false is returned, the caller should copy.
+    virtual bool addRef(const shared_array<const void>& arr, size_t nbytes);
+    // Consume nbytes, which must begin at an address aligned to align, without copying, if supported.
+    // When NULL is returned, the caller should copy.
+    virtual std::shared_ptr<const void> takeRef(size_t nbytes, size_t align);
+protected:
+
     constexpr Buffer(bool be, uint8_t* buf, size_t n) :pos(buf), limit(buf+n), be(be) {}
     virtual ~Buffer() {}
 public:
@@ -139,6 +150,8 @@ public:
     {refill(isize);}
     virtual ~EvOutBuf();
     virtual bool refill(size_t more) override final;
+    // large arrays are appended by reference
+    virtual bool addRef(const shared_array<const void>& arr, size_t nbytes) override final;
 };
 
 //! deserialize from an evbuffer, possibly segmented
@@ -157,6 +170,23 @@ public:
     virtual ~EvInBuf();
 
     virtual bool refill(size_t more) override final;
+    // large arrays received into a single segment are consumed by reference
+    virtual std::shared_ptr<const void> takeRef(size_t nbytes, size_t align) override final;
+};
+
+//! Collects the bodies of a segmented message into an evbuffer.
+//! Segments are copied into a few contiguous chains, which grow with the message,
+//! instead of keeping one chain per segment.  As the complete message is decoded,
+//! its memory is then released in large blocks.
+struct PVXS_API SegCollector
+{
+    size_t room = 0u;  // contiguous space remaining in the last chain of dest
+    size_t total = 0u; // bytes collected for the current message
+
+    //! Move len bytes from the front of src to the end of dest.
+    void append(evbuffer *dest, evbuffer *src, size_t len);
+    //! Call between messages
+    void reset() { room = total = 0u; }
 };
 
 // assumes prior buf.ensure(M) where M>=N
@@ -421,6 +451,10 @@ void to_wire(Buffer& buf, const shared_array<const void>& varr)
 
         auto src = reinterpret_cast<const char*>(arr.data());
 
+        // already in native order, maybe avoid copying
+        if(std::is_same<E, C>::value && buf.be==hostBE && buf.addRef(varr, arr.size()*sizeof(C)))
+            return;
+
         for(size_t nremain = arr.size()*sizeof(C); nremain;) {
             if(!buf.ensure(sizeof(C))) {
                 buf.fault(__FILE__, __LINE__);
@@ -434,14 +468,7 @@ void to_wire(Buffer& buf, const shared_array<const void>& varr)
                 memcpy(buf.save(), src, nbytes);
 
             } else { // must swap byte order
-                auto dest = buf.save();
-
-                for(size_t i=0; i<nbytes; i+=sizeof(C)) {
-                    for(size_t n=0u; n<sizeof(C); n++) {
-                        dest[i + sizeof(C)-1-n] = src[i + n];
-
-                    }
-                }
+                swapCopy(buf.save(), src, nbytes/sizeof(C), sizeof(C));
             }
 
             src += nbytes;
@@ -463,6 +490,16 @@ void from_wire(Buffer& buf, shared_array<const void>& varr)
 {
     Size slen{};
     from_wire(buf, slen);
+
+    // already in native order, maybe avoid copying
+    if(std::is_pod<C>::value && std::is_same<E, C>::value && buf.be==hostBE && buf.good()) {
+        if(auto ref = buf.takeRef(slen.size*sizeof(C), alignof(E))) {
+            shared_array<const E> arr(ref, static_cast<const E*>(ref.get()), slen.size);
+            varr = arr.template castTo<const void>();
+            return;
+        }
+    }
+
     shared_array<E> arr(slen.size);
 
     if(std::is_pod<C>::value) {
@@ -483,14 +520,7 @@ void from_wire(Buffer& buf, shared_array<const void>& varr)
                 memcpy(dest, buf.save(), nbytes);
 
             } else { // must swap byte order
-                auto src = buf.save();
-
-                for(size_t i=0; i<nbytes; i+=sizeof(C)) {
-                    for(size_t n=0u; n<sizeof(C); n++) {
-                        dest[i + sizeof(C)-1-n] = src[i + n];
-
-                    }
-                }
+                swapCopy(dest, buf.save(), nbytes/sizeof(C), sizeof(C));
             }
 
             dest += nbytes;
@@ -522,6 +552,9 @@ struct pva_version {
     };
 };
 
+// range of connection priority (aka. QoS)
+constexpr unsigned pva_max_priority = 99u;
+
 /* values from flags field of header
  * flags[0] - 0 app, 1 control
  * flags[1:3] - unused
@@ -603,7 +603,15 @@ public:
     //! Store raw pvRequest blob.
     SubBuilder& rawRequest(const Value& r) { this->_rawRequest(r); return _sb(); }
 
-    SubBuilder& priority(int p) { this->_prio = p; return _sb(); }
+    /** Channel priority.  0 (default) through 99.
+     *
+     *  Channels to a server with different priorities use separate TCP connections.
+     *  The server services connections with a non-zero priority first,
+     *  in three bands (1-33, 34-66, and 67-99) with the higher band served first.
+     *  Priorities within a band are treated equally.
+     *  A busy connection periodically yields to lower priorities, which are not starved.
+     */
+    SubBuilder& priority(int p) { this->_prio = p<0 ? 0u : unsigned(p); return _sb(); }
     SubBuilder& server(const std::string& s) { this->_server = s; return _sb(); }
 
 #ifdef PVXS_EXPERT_API_ENABLED
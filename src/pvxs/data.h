@@ -478,6 +478,50 @@ struct PVXS_API LookupError : public std::runtime_error
     virtual ~LookupError();
 };
 
+/** Pre-resolved reference to a descendant field.
+ *
+ * Parses a field name expression, as accepted by Value::operator[],
+ * and resolves it against the type of a prototype Value.
+ * Later lookups through Value::operator[](const FieldRef&) on any Value
+ * of the same type (eg. from cloneEmpty() ) are then O(1).
+ *
+ * Lookups on a Value of any other type, or an expression which
+ * passes through a Union, Any, or array of Struct, fall back to parsing the expression.
+ *
+ * @code
+ * Value proto = nt::NTScalar{TypeCode::Float64}.create();
+ * const FieldRef value(proto, "value");
+ * const FieldRef secs(proto, "timeStamp.secondsPastEpoch");
+ * for(...) {
+ *     auto val(proto.cloneEmpty());
+ *     val[value] = 42.0;
+ *     val[secs] = 1234;
+ * }
+ * @endcode
+ *
+ * @since 0.3.0
+ */
+class PVXS_API FieldRef {
+    friend class Value;
+    std::string expr;
+    // type resolved against.  Holds a reference so that the address can't be reused.
+    std::shared_ptr<const impl::FieldDesc> type;
+    // offset from type to field, when resolved
+    size_t offset = 0u;
+public:
+    //! An empty expression.  Refers to the Value itself.
+    FieldRef() = default;
+    //! Unresolved.  Equivalent to operator[](expr)
+    explicit FieldRef(const std::string& expr);
+    //! Resolve against the type of proto
+    FieldRef(const Value& proto, const std::string& expr);
+
+    //! The field name expression
+    inline const std::string& name() const { return expr; }
+    //! Was this expression resolved to a fixed offset?
+    inline bool resolved() const { return !!type; }
+};
+
 /** Generic data container
  *
  * References a single data field, which may be free-standing (eg. "int x = 5;")
@@ -509,6 +553,8 @@ private:
     // Build new Value with the given type.  Used by TypeDef
     explicit Value(const std::shared_ptr<const impl::FieldDesc>& desc);
     Value(const std::shared_ptr<const impl::FieldDesc>& desc, Value& parent);
+    // assign() from Struct of the same type
+    void copyMarked(const Value& o);
 public:
     // movable and copyable
     Value(const Value&) = default;
@@ -539,6 +585,37 @@ public:
     //! Use to allocate members for an array of Struct and array of Union
     Value allocMember();
 
+    /** Column-wise copy of an array of Struct.
+     *
+     * Possible when the Struct[] element type has only scalar and string members,
+     * and/or sub-structures with only such members.
+     * Returns a Struct with the same member names, where each member is
+     * instead an array with one entry per element.  eg. "double x" becomes "double[] x".
+     *
+     * @code
+     * auto cols = val["table"].columns(); // initially empty
+     * cols["x"] = shared_array<const double>({1.0, 2.0});
+     * cols["y"] = shared_array<const std::string>({"one", "two"});
+     * val["table"].assign(cols); // two elements
+     * @endcode
+     *
+     * Assigning such a Struct back to the Struct[] field stores it column-wise.
+     * All columns must then have the same length.
+     * A Struct[] stored column-wise is encoded without creating a Value for each element.
+     * Received data is decoded element-wise, unless the field is already stored column-wise,
+     * in which case it is decoded column-wise (eg. after assigning an empty columns()).
+     * Each access as shared_array<const Value> creates all elements anew, and changes to these copies do not change the field.
+     * Indexing through a const Value, eg. "table[3]", creates only that element.
+     * Indexing through a non-const Value first switches the field to element-wise storage,
+     * so that changes made through the result are kept.
+     *
+     * Arrays are shared, not copied, if the field is already stored column-wise.
+     *
+     * @throws NoConvert if not a Struct[] of suitable type, or if an element is null.
+     * @since 0.3.0
+     */
+    Value columns() const;
+
     //! Does this Value actually reference some underlying storage
     inline bool valid() const { return desc; }
     inline explicit operator bool() const { return desc; }
@@ -717,6 +794,21 @@ public:
     Value lookup(const std::string& name);
     const Value lookup(const std::string& name) const;
 
+    /** Access a descendant field through a pre-resolved reference.
+     *
+     * Equivalent to operator[](ref.name()) , without parsing
+     * when this Value has the type which ref was resolved against.
+     *
+     * @since 0.3.0
+     */
+    Value operator[](const FieldRef& ref);
+    const Value operator[](const FieldRef& ref) const;
+
+    //! Equivalent to lookup(ref.name())
+    //! @since 0.3.0
+    Value lookup(const FieldRef& ref);
+    const Value lookup(const FieldRef& ref) const;
+
     //! Number of child fields.
     //! only Struct, StructA, Union, UnionA return non-zero
     size_t nmembers() const;
@@ -915,6 +1007,41 @@ Value::imarked() const noexcept {
 PVXS_API
 std::ostream& operator<<(std::ostream& strm, const Value::Fmt& fmt);
 
+/** Opt-in recycling of Value storage.
+ *
+ * When enabled, the storage of a Struct Value which is no longer referenced
+ * is retained for reuse by a later Value of the same type.
+ * eg. as allocated by Value::cloneEmpty() or Value::clone() .
+ * Retained storage is freed when the type itself is no longer referenced.
+ *
+ * Pools are reported by instanceSnapshot() as "StructPool" (number of pools),
+ * and "StructPoolFree" (number of retained allocations).
+ * cf. valuePoolStats()
+ *
+ * @param limit Maximum number of allocations retained for each type.
+ *              Zero (the default) disables retention, and resets the hit and miss counts.
+ *
+ * @since 0.3.0
+ */
+PVXS_API
+void setValuePoolLimit(size_t limit);
+
+//! Cumulative counts of Value storage pool use.  cf. valuePoolStats()
+//! @since 0.3.0
+struct ValuePoolStats {
+    //! Allocations which reused retained storage
+    size_t hit = 0u;
+    //! Allocations from the heap while retention was enabled
+    size_t miss = 0u;
+};
+
+/** Counts of Value storage pool use since retention was last disabled.
+ *  cf. setValuePoolLimit()
+ *  @since 0.3.0
+ */
+PVXS_API
+ValuePoolStats valuePoolStats();
+
 inline
 std::ostream& operator<<(std::ostream& strm, const Value& val)
 {
@@ -54,6 +54,14 @@ struct Report {
         std::shared_ptr<const server::ClientCredentials> credentials;
         //! transmit and receive counters in bytes
         size_t tx{}, rx{};
+        //! Number of operations waiting for space in the transmit buffer.
+        //! Only from Server::report()
+        //! @since 0.3.0
+        size_t backlog{};
+        //! PVA connection priority.  0 (default) through 99.
+        //! Connections with a non-zero priority are serviced first, in three bands (1-33, 34-66, 67-99).
+        //! @since 0.3.0
+        unsigned priority{};
         //! Channels currently connected through this socket
         std::list<Channel> channels;
     };
@@ -169,6 +169,40 @@ struct PVXS_API Config {
     //! @since 0.2.0
     double tcpTimeout = 40.0;
 
+    //! Number of worker threads which handle TCP connections.
+    //! New connections are distributed round-robin between workers.
+    //! The first worker also accepts new connections and sends beacons.
+    //! Zero is treated as one.
+    //! @since 0.3.0
+    unsigned tcpWorkers = 1u;
+
+    //! If true, and tcpWorkers>1, then each interface binds one listening socket per worker
+    //! with SO_REUSEPORT so that the OS distributes new connections between workers.
+    //! This allows a storm of (re)connecting clients to be accepted in parallel.
+    //! Falls back to a single listening socket where SO_REUSEPORT is not supported,
+    //! or when built with libevent < 2.1.
+    //!
+    //! @note With SO_REUSEPORT, another process with the same user ID, which also sets SO_REUSEPORT,
+    //!       could bind the same TCP port.  Choose tcp_port accordingly.
+    //! @since 0.3.0
+    bool tcpReusePort = false;
+
+    //! If true, then each type description sent to a client is remembered for the life of the TCP connection.
+    //! Repeats, eg. the same type used by many channels, are then sent as a short reference.
+    //! Clients must decode every type description they are received,
+    //! including in replies to operations which they have since canceled.
+    //! PVXS clients do so.  Some other PVA client implementations may not.
+    //! @since 0.3.0
+    bool typeCache = false;
+
+    //! If non-zero, messages with a body longer than this many bytes are sent
+    //! as a series of segments, each with a body of at most this many bytes.
+    //! The segments of one message are sent consecutively, as the PVA protocol
+    //! does not allow other messages to be interleaved with them.
+    //! Zero (default) never segments.
+    //! @since 0.3.0
+    size_t segmentSize = 0u;
+
     //! Server unique ID.  Only meaningful in readback via Server::config()
     ServerGUID guid{};
 
@@ -250,6 +250,18 @@ struct PVXS_API Source {
 
     //! Print status information.
     virtual void show(std::ostream& strm);
+
+    /** Optional prefilter for onSearch().
+     *
+     *  Return false only if this Source would certainly not claim() a Channel name.
+     *  onSearch() is not called if this returns false for every name in a Search.
+     *
+     *  May be called concurrently with any other method, so should not block.
+     *  Default returns true.
+     *
+     * @since 0.3.0
+     */
+    virtual bool mayClaim(const char* name) const;
 };
 
 }} // namespace pvxs::server
@@ -235,39 +235,43 @@ Report Server::report(bool zero) const
 
     Report ret;
 
-    pvt->acceptor_loop.call([this, &ret, zero](){
+    for(auto& worker : pvt->workers) {
+        worker->loop.call([&worker, &ret, zero](){
 
-        for(auto& pair : pvt->connections) {
-            auto conn = pair.first;
+            for(auto& pair : worker->connections) {
+                auto conn = pair.first;
 
-            ret.connections.emplace_back();
-            auto& sconn = ret.connections.back();
-            sconn.peer = conn->peerName;
-            sconn.credentials = conn->cred;
-            sconn.tx = conn->statTx;
-            sconn.rx = conn->statRx;
+                ret.connections.emplace_back();
+                auto& sconn = ret.connections.back();
+                sconn.peer = conn->peerName;
+                sconn.credentials = conn->cred;
+                sconn.tx = conn->statTx;
+                sconn.rx = conn->statRx;
+                sconn.backlog = conn->backlog.size();
+                sconn.priority = conn->priority;
 
-            if(zero) {
-                conn->statTx = conn->statRx = 0u;
-            }
+                if(zero) {
+                    conn->statTx = conn->statRx = 0u;
+                }
 
-            for(auto& pair : conn->chanBySID) {
-                auto& chan = pair.second;
+                for(auto& pair : conn->chanBySID) {
+                    auto& chan = pair.second;
 
-                sconn.channels.emplace_back();
-                auto& schan = sconn.channels.back();
-                schan.name = chan->name;
-                schan.tx = chan->statTx;
-                schan.rx = chan->statRx;
-                schan.info = chan->reportInfo;
+                    sconn.channels.emplace_back();
+                    auto& schan = sconn.channels.back();
+                    schan.name = chan->name;
+                    schan.tx = chan->statTx;
+                    schan.rx = chan->statRx;
+                    schan.info = chan->reportInfo;
 
-                if(zero) {
-                    chan->statTx = chan->statRx = 0u;
+                    if(zero) {
+                        chan->statTx = chan->statRx = 0u;
+                    }
                 }
             }
-        }
 
-    });
+        });
+    }
 
     return ret;
 }
@@ -313,57 +317,62 @@ std::ostream& operator<<(std::ostream& strm, const Server& serv)
 #undef CASE
             }
             strm<<"\n";
+        });
 
-            Indented I(strm);
+        Indented I(strm);
 
-            for(auto& pair : serv.pvt->connections) {
-                auto conn = pair.first;
+        for(auto& worker : serv.pvt->workers) {
+            worker->loop.call([&worker, &strm, detail](){
+                for(auto& pair : worker->connections) {
+                    auto conn = pair.first;
 
-                strm<<indent{}<<"Peer"<<conn->peerName
-                    <<" backlog="<<conn->backlog.size()
-                    <<" TX="<<conn->statTx<<" RX="<<conn->statRx
-                    <<" auth="<<conn->cred->method<<"\n";
-                if(detail>2)
-                    strm<<*conn->cred;
+                    strm<<indent{}<<"Peer"<<conn->peerName
+                        <<" prio="<<conn->priority
+                        <<" backlog="<<conn->backlog.size()
+                        <<" TX="<<conn->statTx<<" RX="<<conn->statRx
+                        <<" auth="<<conn->cred->method<<"\n";
+                    if(detail>2)
+                        strm<<*conn->cred;
 
-                if(detail<=2)
-                    continue;
+                    if(detail<=2)
+                        continue;
 
-                Indented I(strm);
+                    Indented I(strm);
 
-                for(auto& pair : conn->chanBySID) {
-                    auto& chan = pair.second;
-                    strm<<indent{}<<chan->name<<" TX="<<chan->statTx<<" RX="<<chan->statRx<<' ';
-
-                    if(chan->state==ServerChan::Creating) {
-                        strm<<"CREATING sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    } else if(chan->state==ServerChan::Destroy) {
-                        strm<<"DESTROY  sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    } else if(chan->opByIOID.empty()) {
-                        strm<<"IDLE     sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    }
+                    for(auto& pair : conn->chanBySID) {
+                        auto& chan = pair.second;
+                        strm<<indent{}<<chan->name<<" TX="<<chan->statTx<<" RX="<<chan->statRx<<' ';
+
+                        if(chan->state==ServerChan::Creating) {
+                            strm<<"CREATING sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        } else if(chan->state==ServerChan::Destroy) {
+                            strm<<"DESTROY  sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        } else if(chan->opByIOID.empty()) {
+                            strm<<"IDLE     sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        }
 
-                    for(auto& pair : chan->opByIOID) {
-                        auto& op = pair.second;
-                        if(!op) {
-                            strm<<"NULL ioid="<<pair.first<<"\n";
-                        } else {
-                            strm<<indent{};
-                            switch (op->state) {
+                        for(auto& pair : chan->opByIOID) {
+                            auto& op = pair.second;
+                            if(!op) {
+                                strm<<"NULL ioid="<<pair.first<<"\n";
+                            } else {
+                                strm<<indent{};
+                                switch (op->state) {
 #define CASE(STATE) case ServerOp::STATE: strm<< #STATE; break
-                            CASE(Creating);
-                            CASE(Idle);
-                            CASE(Executing);
-                            CASE(Dead);
+                                CASE(Creating);
+                                CASE(Idle);
+                                CASE(Executing);
+                                CASE(Dead);
 #undef CASE
+                                }
+                                strm<<" ioid="<<pair.first<<" ";
+                                op->show(strm);
                             }
-                            strm<<" ioid="<<pair.first<<" ";
-                            op->show(strm);
                         }
                     }
                 }
-            }
-        });
+            });
+        }
     }
 
     return strm;
@@ -424,6 +433,11 @@ Server::Pvt::Pvt(const Config &conf)
     }
 
 
+    workers.emplace_back(new ServerWorker(acceptor_loop));
+    for(auto i : range(1u, effective.tcpWorkers)) {
+        workers.emplace_back(new ServerWorker(evbase(SB()<<"PVXTCP"<<i, epicsThreadPriorityCAServerLow-2)));
+    }
+
     acceptor_loop.call([this](){
         // from accepter worker
 
@@ -495,6 +509,15 @@ Server::Pvt::Pvt(const Config &conf)
 Server::Pvt::~Pvt()
 {
     stop();
+
+    // free fan out listeners on the loops which own them
+    for(auto& iface : interfaces) {
+        for(auto& fan : iface.fanout) {
+            fan.worker->loop.call([&fan](){
+                fan.listener.reset();
+            });
+        }
+    }
 }
 
 void Server::Pvt::start()
@@ -518,6 +541,11 @@ void Server::Pvt::start()
             if(evconnlistener_enable(iface.listener.get())) {
                 log_err_printf(serversetup, "Error enabling listener on %s\n", iface.name.c_str());
             }
+            for(auto& fan : iface.fanout) {
+                if(evconnlistener_enable(fan.listener.get())) {
+                    log_err_printf(serversetup, "Error enabling fan out listener on %s\n", iface.name.c_str());
+                }
+            }
             log_debug_printf(serversetup, "Server enabled listener on %s\n", iface.name.c_str());
         }
     });
@@ -576,20 +604,43 @@ void Server::Pvt::stop()
             if(evconnlistener_disable(iface.listener.get())) {
                 log_err_printf(serversetup, "Error disabling listener on %s\n", iface.name.c_str());
             }
+            for(auto& fan : iface.fanout) {
+                if(evconnlistener_disable(fan.listener.get())) {
+                    log_err_printf(serversetup, "Error disabling fan out listener on %s\n", iface.name.c_str());
+                }
+            }
             log_debug_printf(serversetup, "Server disabled listener on %s\n", iface.name.c_str());
         }
 
-        // close current TCP connections
-        auto conns = std::move(connections);
-        for(auto& pair : conns) {
-            pair.second->bev.reset();
-            pair.second->cleanup();
-        }
+    });
+
+    // close current TCP connections
+    for(auto& worker : workers) {
+        worker->loop.call([&worker]()
+        {
+            auto conns = std::move(worker->connections);
+            for(auto& pair : conns) {
+                pair.second->bev.reset();
+                pair.second->cleanup();
+            }
+        });
+    }
 
+    acceptor_loop.call([this]()
+    {
         state = Stopped;
     });
 }
 
+bool Server::Pvt::mayClaimAny(const Source& src, const Source::Search& op)
+{
+    for(const auto& name : op._names) {
+        if(src.mayClaim(name._name))
+            return true;
+    }
+    return false;
+}
+
 void Server::Pvt::onSearch(const UDPManager::Search& msg)
 {
     // on UDPManager worker
@@ -621,7 +672,8 @@ void Server::Pvt::onSearch(const UDPManager::Search& msg)
         auto G(sourcesLock.lockReader());
         for(const auto& pair : sources) {
             try {
-                pair.second->onSearch(searchOp);
+                if(mayClaimAny(*pair.second, searchOp))
+                    pair.second->onSearch(searchOp);
             }catch(std::exception& e){
                 log_exc_printf(serversetup, "Unhandled error in Source::onSearch for '%s' : %s\n",
                            pair.first.second.c_str(), e.what());
@@ -700,23 +752,29 @@ void Server::Pvt::doBeacons(short evt)
 
     assert(M.good() && H.good());
 
+    UDPTxBatch batch;
     for(const auto& dest : beaconDest) {
-        int ntx = sendto(beaconSender.sock, (char*)beaconMsg.data(), pktlen, 0, &dest->sa, dest.size());
+        batch.push(beaconMsg.data(), pktlen, dest);
+    }
+
+    batch.send(beaconSender.sock);
+
+    for(auto i : range(batch.size())) {
+        auto& msg = batch[i];
 
-        if(ntx<0) {
-            int err = evutil_socket_geterror(beaconSender.sock);
+        if(msg.ntx<0) {
             auto lvl = Level::Warn;
-            if(err==EINTR || err==EPERM)
+            if(msg.err==EINTR || msg.err==EPERM)
                 lvl = Level::Debug;
             log_printf(serverio, lvl, "Beacon tx error (%d) %s\n",
-                       err, evutil_socket_error_to_string(err));
+                       msg.err, evutil_socket_error_to_string(msg.err));
 
-        } else if(unsigned(ntx)<pktlen) {
+        } else if(size_t(msg.ntx)<pktlen) {
             log_warn_printf(serverio, "Beacon truncated %u < %u",
-                       unsigned(ntx), unsigned(pktlen));
+                       unsigned(msg.ntx), unsigned(pktlen));
 
         } else {
-            log_debug_printf(serverio, "Beacon tx to %s\n", dest.tostring().c_str());
+            log_debug_printf(serverio, "Beacon tx to %s\n", msg.dest.tostring().c_str());
         }
     }
 
@@ -746,6 +804,11 @@ Source::List Source::onList() {
     return Source::List{};
 }
 
+bool Source::mayClaim(const char*) const
+{
+    return true;
+}
+
 void Source::show(std::ostream& strm)
 {
     auto list(onList());
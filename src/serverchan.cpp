@@ -38,6 +38,7 @@ ServerChan::~ServerChan() {
 
 ServerChannelControl::ServerChannelControl(const std::shared_ptr<ServerConn> &conn, const std::shared_ptr<ServerChan>& channel)
     :server(conn->iface->server->internal_self)
+    ,loop(conn->worker->loop.internal())
     ,chan(channel)
 {
     _op = None;
@@ -53,7 +54,7 @@ void ServerChannelControl::onOp(std::function<void(std::unique_ptr<server::Conne
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -68,7 +69,7 @@ void ServerChannelControl::onRPC(std::function<void(std::unique_ptr<server::Exec
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -83,7 +84,7 @@ void ServerChannelControl::onSubscribe(std::function<void(std::unique_ptr<server
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -98,7 +99,7 @@ void ServerChannelControl::onClose(std::function<void(const std::string&)>&& fn)
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch || ch->state==ServerChan::Destroy)
             return;
@@ -153,7 +154,7 @@ void ServerChannelControl::close()
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this](){
+    loop.call([this](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -180,7 +181,7 @@ void ServerChannelControl::_updateInfo(const std::shared_ptr<const ReportInfo>&
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &info](){
+    loop.call([this, &info](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -231,7 +232,8 @@ void ServerConn::handle_SEARCH()
         auto G(iface->server->sourcesLock.lockReader());
         for(const auto& pair : iface->server->sources) {
             try {
-                pair.second->onSearch(op);
+                if(server::Server::Pvt::mayClaimAny(*pair.second, op))
+                    pair.second->onSearch(op);
             }catch(std::exception& e){
                 log_exc_printf(serversearch, "Unhandled error in Source::onSearch for '%s' : %s\n",
                            pair.first.second.c_str(), e.what());
@@ -43,12 +43,21 @@ DEFINE_LOGGER(connio, "pvxs.tcp.io");
 
 DEFINE_LOGGER(remote, "pvxs.remote.log");
 
-ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen)
+typedef epicsGuard<epicsMutex> Guard;
+
+// number of distinct type descriptions remembered per connection when Config::typeCache
+static constexpr size_t tx_type_cache_size = 1024u;
+
+ServerConn::ServerConn(ServIface* iface, ServerWorker *worker, evutil_socket_t sock, struct sockaddr *peer, int socklen)
     :ConnBase(false,
-              bufferevent_socket_new(iface->server->acceptor_loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
+              bufferevent_socket_new(worker->loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
               SockAddr(peer, socklen))
     ,iface(iface)
+    ,worker(worker)
+    ,txRegistry(iface->server->effective.typeCache ? tx_type_cache_size : 0u)
 {
+    txSegment = iface->server->effective.segmentSize;
+
     log_debug_printf(connio, "Client %s connects\n", peerName.c_str());
 
     {
@@ -157,7 +166,9 @@ void ServerConn::handle_CONNECTION_VALIDATION()
 
     std::string selected;
     {
-        M.skip(4+2+2, __FILE__, __LINE__); // ignore unused buffer, introspection size, and QoS
+        uint16_t qos = 0u;
+        M.skip(4+2, __FILE__, __LINE__); // ignore unused buffer and introspection size
+        from_wire(M, qos);
         from_wire(M, selected);
 
         Value auth;
@@ -174,6 +185,9 @@ void ServerConn::handle_CONNECTION_VALIDATION()
                        peerName.c_str(), selected.c_str(),
                        std::string(SB()<<auth).c_str());
 
+            // clients open a separate connection for each channel priority
+            setPriority(qos);
+
             auto C(std::make_shared<server::ClientCredentials>(*cred));
 
             if(selected=="ca") {
@@ -324,7 +338,7 @@ void ServerConn::cleanup()
 {
     log_debug_printf(connsetup, "Client %s Cleanup TCP Connection\n", peerName.c_str());
 
-    iface->server->connections.erase(this);
+    worker->connections.erase(this);
 
     for(auto& pair : opByIOID) {
         if(pair.second->onClose)
@@ -339,6 +353,95 @@ void ServerConn::cleanup()
     }
 }
 
+void ServerBacklog::push(const std::shared_ptr<ServerOp>& op)
+{
+    if(op->inBacklog)
+        return;
+
+    op->inBacklog = true;
+    if(tail)
+        tail->backlogNext = op;
+    else
+        head = op;
+    tail = op.get();
+    count++;
+}
+
+std::shared_ptr<ServerOp> ServerBacklog::pop()
+{
+    std::shared_ptr<ServerOp> ret(std::move(head));
+    if(ret) {
+        head = std::move(ret->backlogNext);
+        if(!head)
+            tail = nullptr;
+        ret->inBacklog = false;
+        count--;
+    }
+    return ret;
+}
+
+void ServerBacklog::clear()
+{
+    // iterate to avoid recursion through ServerOp::backlogNext
+    while(!empty())
+        (void)pop();
+}
+
+void ServerConn::readyReply(const std::shared_ptr<ServerOp>& op)
+{
+    {
+        Guard G(readyLock);
+        readyOps.push_back(op);
+        if(readyScheduled)
+            return; // sendReady() already pending
+        readyScheduled = true;
+    }
+
+    auto self(shared_from_this());
+    worker->loop.dispatch([self]() {
+        self->sendReady();
+    });
+}
+
+void ServerConn::sendReady()
+{
+    decltype (readyOps) todo;
+    {
+        Guard G(readyLock);
+        todo.swap(readyOps);
+        readyScheduled = false;
+    }
+
+    // Send (at most) one reply for each ready operation.
+    // Those with more to send will call readyReply() again for the next loop iteration.
+    for(auto& op : todo) {
+        if(!bev)
+            break;
+
+        auto tx = bufferevent_get_output(bev.get());
+
+        if(!(bufferevent_get_enabled(bev.get())&EV_READ) || evbuffer_get_length(tx)>=tcp_tx_limit) {
+            // connection TX queue is too full
+            backlog.push(op);
+        } else {
+            op->sendReply();
+        }
+    }
+
+    if(bev && (bufferevent_get_enabled(bev.get())&EV_READ)
+            && evbuffer_get_length(bufferevent_get_output(bev.get()))>=tcp_tx_limit)
+        suspendRead();
+}
+
+void ServerConn::suspendRead()
+{
+    // write buffer "full".  stop reading until it drains
+    // TODO configure
+    (void)bufferevent_disable(bev.get(), EV_READ);
+    bufferevent_setwatermark(bev.get(), EV_WRITE, tcp_tx_limit/2, 0);
+    log_debug_printf(connio, "%s suspend READ\n", peerName.c_str());
+}
+
 void ServerConn::bevRead()
 {
     ConnBase::bevRead();
@@ -346,13 +449,8 @@ void ServerConn::bevRead()
     if(bev) {
         auto tx = bufferevent_get_output(bev.get());
 
-        if(evbuffer_get_length(tx)>=tcp_tx_limit) {
-            // write buffer "full".  stop reading until it drains
-            // TODO configure
-            (void)bufferevent_disable(bev.get(), EV_READ);
-            bufferevent_setwatermark(bev.get(), EV_WRITE, tcp_tx_limit/2, 0);
-            log_debug_printf(connio, "%s suspend READ\n", peerName.c_str());
-        }
+        if(evbuffer_get_length(tx)>=tcp_tx_limit)
+            suspendRead();
     }
 }
 
@@ -363,11 +461,11 @@ void ServerConn::bevWrite()
     auto tx = bufferevent_get_output(bev.get());
     // handle pending monitors
 
+    // one reply from each operation in turn.
+    // those with more to send are queued again by readyReply()
     while(!backlog.empty() && evbuffer_get_length(tx)<tcp_tx_limit) {
-        auto fn = std::move(backlog.front());
-        backlog.pop_front();
-
-        fn();
+        auto op(backlog.pop());
+        op->sendReply();
     }
 
     // TODO configure
@@ -379,6 +477,14 @@ void ServerConn::bevWrite()
 }
 
 
+// added in libevent 2.1.1
+#ifndef LEV_OPT_DISABLED
+#  define LEV_OPT_DISABLED 0
+#endif
+
+// listen() backlog of each TCP socket
+static constexpr int listen_backlog = 4;
+
 ServIface::ServIface(const std::string& addr, unsigned short port, server::Server::Pvt *server, bool fallback)
     :server(server)
     ,bind_addr(AF_INET, addr.c_str(), port)
@@ -386,10 +492,23 @@ ServIface::ServIface(const std::string& addr, unsigned short port, server::Serve
 {
     server->acceptor_loop.assertInLoop();
     auto orig_port = bind_addr.port();
+    bool reuseport = server->effective.tcpReusePort && server->workers.size()>1u;
 
     if(evutil_make_listen_socket_reuseable(sock.sock))
         log_warn_printf(connsetup, "Unable to make socket reusable%s", "\n");
 
+#if LIBEVENT_VERSION_NUMBER >= 0x02010000
+    if(reuseport && evutil_make_listen_socket_reuseable_port(sock.sock)) {
+        log_warn_printf(connsetup, "Unable to set SO_REUSEPORT on %s\n", bind_addr.tostring().c_str());
+        reuseport = false;
+    }
+#else
+    if(reuseport) {
+        log_warn_printf(connsetup, "tcpReusePort ignored with libevent < 2.1 on %s\n", bind_addr.tostring().c_str());
+        reuseport = false;
+    }
+#endif
+
     // try to bind to requested port, then fallback to a random port
     while(true) {
         try {
@@ -410,35 +529,102 @@ ServIface::ServIface(const std::string& addr, unsigned short port, server::Serve
         log_warn_printf(connsetup, "Server unable to bind port %u, falling back to %s\n", orig_port, name.c_str());
     }
 
-    // added in libevent 2.1.1
-#ifndef LEV_OPT_DISABLED
-#  define LEV_OPT_DISABLED 0
+    listener = evlisten(evconnlistener_new(server->acceptor_loop.base, onConnS, this, LEV_OPT_DISABLED|LEV_OPT_CLOSE_ON_EXEC, listen_backlog, sock.sock));
+
+    if(!LEV_OPT_DISABLED)
+        evconnlistener_disable(listener.get());
+
+    if(reuseport) {
+        // the kernel will distribute new connections between sockets bound with SO_REUSEPORT
+        try {
+            for(auto i : range(size_t(1u), server->workers.size())) {
+                fanout.emplace_back(this, server->workers[i].get());
+            }
+            log_debug_printf(connsetup, "Interface %s fan out to %zu workers\n", name.c_str(), server->workers.size());
+        }catch(std::system_error& e){
+            log_warn_printf(connsetup, "Interface %s unable to fan out listener, using single socket: %s\n",
+                            name.c_str(), e.what());
+            fanout.clear();
+        }
+    }
+}
+
+ServIface::Fanout::Fanout(ServIface* iface, ServerWorker* worker)
+    :iface(iface)
+    ,worker(worker)
+    ,sock(AF_INET, SOCK_STREAM, 0)
+{
+#if LIBEVENT_VERSION_NUMBER >= 0x02010000
+    if(evutil_make_listen_socket_reuseable(sock.sock) || evutil_make_listen_socket_reuseable_port(sock.sock))
+        throw std::system_error(evutil_socket_geterror(sock.sock), std::system_category());
+#else
+    // not reached.  cf. ServIface::ServIface()
+    throw std::logic_error("SO_REUSEPORT requires libevent >= 2.1");
 #endif
 
-    const int backlog = 4;
-    listener = evlisten(evconnlistener_new(server->acceptor_loop.base, onConnS, this, LEV_OPT_DISABLED|LEV_OPT_CLOSE_ON_EXEC, backlog, sock.sock));
+    auto addr(iface->bind_addr); // port already selected
+    sock.bind(addr);
+
+    // enabled/disabled from the acceptor loop while owned by the worker loop
+    listener = evlisten(evconnlistener_new(worker->loop.base, onConnS, this, LEV_OPT_DISABLED|LEV_OPT_CLOSE_ON_EXEC|LEV_OPT_THREADSAFE, listen_backlog, sock.sock));
 
     if(!LEV_OPT_DISABLED)
         evconnlistener_disable(listener.get());
 }
 
+void ServIface::accept(ServerWorker* worker, evutil_socket_t sock, struct sockaddr *peer, int socklen)
+{
+    if(peer->sa_family!=AF_INET) {
+        log_crit_printf(connsetup, "Interface %s Rejecting !ipv4 client\n", name.c_str());
+        evutil_closesocket(sock);
+        return;
+    }
+    SockAddr peerAddr(peer, socklen);
+
+    // connection is created, and lives, on the worker loop
+    bool queued = worker->loop.tryDispatch([this, worker, sock, peerAddr]() mutable {
+        try {
+            auto conn(std::make_shared<ServerConn>(this, worker, sock, &peerAddr->sa, peerAddr.size()));
+            worker->connections[conn.get()] = std::move(conn);
+        }catch(std::exception& e){
+            log_exc_printf(connsetup, "Interface %s Unhandled error creating connection: %s\n", name.c_str(), e.what());
+            evutil_closesocket(sock);
+        }
+    });
+    if(!queued)
+        evutil_closesocket(sock);
+}
+
 void ServIface::onConnS(struct evconnlistener *listener, evutil_socket_t sock, struct sockaddr *peer, int socklen, void *raw)
 {
     auto self = static_cast<ServIface*>(raw);
     try {
-        if(peer->sa_family!=AF_INET) {
-            log_crit_printf(connsetup, "Interface %s Rejecting !ipv4 client\n", self->name.c_str());
-            evutil_closesocket(sock);
-            return;
+        auto serv = self->server;
+        ServerWorker* worker;
+        if(self->fanout.empty()) {
+            worker = serv->workers[serv->nextWorker++ % serv->workers.size()].get();
+        } else {
+            // other workers accept through their own sockets
+            worker = serv->workers[0].get();
         }
-        auto conn(std::make_shared<ServerConn>(self, sock, peer, socklen));
-        self->server->connections[conn.get()] = std::move(conn);
+        self->accept(worker, sock, peer, socklen);
     }catch(std::exception& e){
         log_exc_printf(connsetup, "Interface %s Unhandled error in accept callback: %s\n", self->name.c_str(), e.what());
         evutil_closesocket(sock);
     }
 }
 
+void ServIface::Fanout::onConnS(struct evconnlistener *listener, evutil_socket_t sock, struct sockaddr *peer, int socklen, void *raw)
+{
+    auto self = static_cast<Fanout*>(raw);
+    try {
+        self->iface->accept(self->worker, sock, peer, socklen);
+    }catch(std::exception& e){
+        log_exc_printf(connsetup, "Interface %s Unhandled error in accept callback: %s\n", self->iface->name.c_str(), e.what());
+        evutil_closesocket(sock);
+    }
+}
+
 ServerOp::~ServerOp() {}
 
 }} // namespace pvxs::impl
@@ -9,10 +9,12 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #include <memory>
 #include <atomic>
 
 #include <epicsEvent.h>
+#include <epicsMutex.h>
 
 #include <pvxs/server.h>
 #include <pvxs/source.h>
@@ -28,6 +30,7 @@ namespace pvxs {namespace impl {
 struct ServIface;
 struct ServerConn;
 struct ServerChan;
+struct ServerWorker;
 
 // base for tracking in-progress operations.  cf. ServerConn::opByIOID and ServerChan::opByIOID
 struct ServerOp
@@ -52,6 +55,37 @@ struct ServerOp
     virtual ~ServerOp() =0;
 
     virtual void show(std::ostream& strm) const =0;
+
+    // called from the connection worker after ServerConn::readyReply()
+    virtual void sendReply() {}
+
+    // next in ServerConn::backlog.  Only access from connection worker
+    std::shared_ptr<ServerOp> backlogNext;
+    bool inBacklog = false;
+};
+
+// FIFO of operations waiting for space in the TX buffer of a ServerConn.
+// Intrusive (cf. ServerOp::backlogNext) so that each operation appears at most once,
+// and memory use is bounded by the number of operations.
+// Only access from connection worker.
+struct ServerBacklog
+{
+    std::shared_ptr<ServerOp> head;
+    ServerOp* tail = nullptr;
+    size_t count = 0u;
+
+    ServerBacklog() = default;
+    ServerBacklog(const ServerBacklog&) = delete;
+    ServerBacklog& operator=(const ServerBacklog&) = delete;
+    ~ServerBacklog() { clear(); }
+
+    inline bool empty() const { return !head; }
+    inline size_t size() const { return count; }
+
+    // append, unless already queued
+    void push(const std::shared_ptr<ServerOp>& op);
+    std::shared_ptr<ServerOp> pop();
+    void clear();
 };
 
 struct ServerChannelControl : public server::ChannelControl
@@ -69,6 +103,8 @@ struct ServerChannelControl : public server::ChannelControl
     virtual void _updateInfo(const std::shared_ptr<const ReportInfo>& info) override final;
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // connection worker
+    const evbase loop;
     const std::weak_ptr<ServerChan> chan;
 
     INST_COUNTER(ServerChannelControl);
@@ -108,6 +144,8 @@ struct ServerChan
 struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerConn>
 {
     ServIface* const iface;
+    // worker whose loop handles all I/O and operation state for this connection
+    ServerWorker* const worker;
 
     std::shared_ptr<const server::ClientCredentials> cred;
 
@@ -115,17 +153,29 @@ struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerC
     std::map<uint32_t, std::shared_ptr<ServerChan> > chanBySID;
     std::map<uint32_t, std::shared_ptr<ServerOp> > opByIOID;
 
-    std::list<std::function<void()>> backlog;
+    // type descriptions already sent.  cf. Config::typeCache
+    TypeCache txRegistry;
+
+    // Operations with replies to send once the TX buffer drains.  Served round-robin.
+    ServerBacklog backlog;
+
+    // Operations with a reply to send.  Drained by one sendReady() per loop iteration.
+    epicsMutex readyLock;
+    std::vector<std::shared_ptr<ServerOp>> readyOps; // guarded by readyLock
+    bool readyScheduled = false; // guarded by readyLock
 
     INST_COUNTER(ServerConn);
 
-    ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen);
+    ServerConn(ServIface* iface, ServerWorker* worker, evutil_socket_t sock, struct sockaddr *peer, int socklen);
     ServerConn(const ServerConn&) = delete;
     ServerConn& operator=(const ServerConn&) = delete;
     ~ServerConn();
 
     const std::shared_ptr<ServerChan>& lookupSID(uint32_t sid);
 
+    // Queue op->sendReply() to be called from the worker.  May be called from any thread.
+    void readyReply(const std::shared_ptr<ServerOp>& op);
+
 private:
 #define CASE(Op) virtual void handle_##Op() override final;
     CASE(ECHO);
@@ -157,6 +207,8 @@ private:
     //void bevEvent(short events);
     virtual void bevRead() override final;
     virtual void bevWrite() override final;
+    void sendReady();
+    void suspendRead();
 };
 
 struct ServIface
@@ -169,11 +221,46 @@ struct ServIface
     evsocket sock;
     evlisten listener;
 
+    //! Additional SO_REUSEPORT listening socket bound to the same address,
+    //! whose connections are serviced by one worker.
+    //! cf. Config::tcpReusePort
+    struct Fanout {
+        ServIface* const iface;
+        ServerWorker* const worker;
+
+        evsocket sock;
+        evlisten listener;
+
+        Fanout(ServIface* iface, ServerWorker* worker);
+        Fanout(const Fanout&) = delete;
+        Fanout& operator=(const Fanout&) = delete;
+
+        static void onConnS(struct evconnlistener *listener, evutil_socket_t sock, struct sockaddr *peer, int socklen, void *raw);
+    };
+    // empty unless Config::tcpReusePort
+    std::list<Fanout> fanout;
+
     ServIface(const std::string& addr, unsigned short port, server::Server::Pvt *server, bool fallback);
 
+    // hand off a newly accepted socket to the worker which will own the new ServerConn
+    void accept(ServerWorker* worker, evutil_socket_t sock, struct sockaddr *peer, int socklen);
+
     static void onConnS(struct evconnlistener *listener, evutil_socket_t sock, struct sockaddr *peer, int socklen, void *raw);
 };
 
+//! An event loop, and the TCP connections which it services.
+struct ServerWorker
+{
+    const evbase loop;
+
+    // only access from loop worker
+    std::map<ServerConn*, std::shared_ptr<ServerConn> > connections;
+
+    explicit ServerWorker(const evbase& loop) :loop(loop) {}
+    ServerWorker(const ServerWorker&) = delete;
+    ServerWorker& operator=(const ServerWorker&) = delete;
+};
+
 
 //! Home of the magic "server" PV used by "pvinfo"
 struct ServerSource : public server::Source
@@ -221,8 +308,14 @@ struct Server::Pvt
     std::vector<SockAddr> beaconDest;
     std::vector<SockAddr> ignoreList;
 
+    // New connections are assigned round-robin to one of these.
+    // workers[0] shares acceptor_loop.  Only modified from Pvt ctor.
+    // Must outlive interfaces, whose fan out listeners use worker loops.
+    std::vector<std::unique_ptr<ServerWorker> > workers;
+    // only access from acceptor worker
+    size_t nextWorker = 0u;
+
     std::list<ServIface> interfaces;
-    std::map<ServerConn*, std::shared_ptr<ServerConn> > connections;
 
     evsocket beaconSender;
     evevent beaconTimer;
@@ -253,6 +346,9 @@ struct Server::Pvt
     void start();
     void stop();
 
+    // false if src->mayClaim() rejects every name
+    static bool mayClaimAny(const Source& src, const Source::Search& op);
+
 private:
     void onSearch(const UDPManager::Search& msg);
     void doBeacons(short evt);
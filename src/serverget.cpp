@@ -85,7 +85,7 @@ struct ServerGPR : public ServerOp
             } else if(state==Creating) {
                 // connect()
                 if(cmd!=CMD_RPC) {
-                    to_wire(R, type.get());
+                    to_wire(R, type, conn->txRegistry);
                 }
                 state = Idle;
 
@@ -94,8 +94,7 @@ struct ServerGPR : public ServerOp
                     to_wire_valid(R, value, &pvMask); // GET and PUT/Get reply with bitmask and partial value
 
                 } else if(cmd==CMD_RPC) {
-                    auto type = Value::Helper::desc(value);
-                    to_wire(R, type);
+                    to_wire(R, Value::Helper::type(value), conn->txRegistry);
                     if(value)
                         to_wire_full(R, value);
                 }
@@ -117,7 +116,7 @@ struct ServerGPR : public ServerOp
                 conn->opByIOID.erase(it);
 
                 if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
+                    conn->worker->loop.dispatch([self](){
                         self->onClose("");
                     });
 
@@ -168,6 +167,7 @@ struct ServerGPRConnect : public server::ConnectOp
                      const Value& request,
                      const std::weak_ptr<ServerGPR>& op)
         :server(server)
+        ,loop(conn->worker->loop.internal())
         ,op(op)
     {
         switch(cmd) {
@@ -189,7 +189,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &prototype](){
+        loop.call([this, &prototype](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
@@ -216,7 +216,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating)
                     oper->doReply(Value(), msg);
@@ -229,7 +229,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onGet = std::move(fn);
         });
@@ -239,7 +239,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onPut = std::move(fn);
         });
@@ -249,13 +249,14 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    const evbase loop;
     const std::weak_ptr<ServerGPR> op;
 
     INST_COUNTER(ServerGPRConnect);
@@ -270,6 +271,7 @@ struct ServerGPRExec : public server::ExecOp
                   //const Value& request,
                   const std::shared_ptr<ServerGPR>& op)
         :server(server)
+        ,loop(conn->worker->loop.internal())
         ,op(op)
     {
         switch(cmd) {
@@ -294,7 +296,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &val](){
+        loop.call([this, &val](){
             if(auto oper = op.lock()) {
                 oper->doReply(val, std::string());
             }
@@ -308,7 +310,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 oper->doReply(Value(), msg);
             }
@@ -320,7 +322,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onCancel = std::move(fn);
         });
@@ -332,10 +334,11 @@ struct ServerGPRExec : public server::ExecOp
         if(!serv)
             throw std::logic_error("Can't start timer on deal server");
 
-        return Timer::Pvt::buildOneShot(delay, serv->acceptor_loop.internal(), std::move(fn));
+        return Timer::Pvt::buildOneShot(delay, loop, std::move(fn));
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    const evbase loop;
     const std::weak_ptr<ServerGPR> op;
 
     INST_COUNTER(ServerGPRExec);
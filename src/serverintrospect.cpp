@@ -21,7 +21,7 @@ struct ServerIntrospect : public ServerOp
     {}
     virtual ~ServerIntrospect() {}
 
-    void doReply(const FieldDesc* type, const Status& sts)
+    void doReply(const std::shared_ptr<const FieldDesc>& type, const Status& sts)
     {
         if(state != ServerOp::Executing)
             return;
@@ -39,7 +39,7 @@ struct ServerIntrospect : public ServerOp
             to_wire(R, uint32_t(ioid));
             to_wire(R, sts);
             if(type)
-                to_wire(R, type);
+                to_wire(R, type, conn->txRegistry);
         }
 
         ch->statTx += conn->enqueueTxBody(CMD_GET_FIELD);
@@ -63,6 +63,7 @@ struct ServerIntrospectControl : public server::ConnectOp
                             const std::weak_ptr<server::Server::Pvt>& server,
                             const std::weak_ptr<ServerIntrospect>& op)
         :server(server)
+        ,loop(conn->worker->loop.internal())
         ,op(op)
     {
         _op = Info;
@@ -75,7 +76,7 @@ struct ServerIntrospectControl : public server::ConnectOp
 
     virtual void connect(const Value& prototype) override final
     {
-        auto desc = Value::Helper::desc(prototype);
+        auto desc = Value::Helper::type(prototype);
         if(!desc)
             throw std::logic_error("Can't reply to GET_FIELD with Null prototype");
         Status sts{Status::Ok};
@@ -88,13 +89,13 @@ struct ServerIntrospectControl : public server::ConnectOp
         doReply(nullptr, sts);
     }
 
-    void doReply(const FieldDesc* type, const Status& sts)
+    void doReply(const std::shared_ptr<const FieldDesc>& type, const Status& sts)
     {
         auto serv = server.lock();
         if(!serv)
             return; // soft fail if already completed, canceled, disconnected, ....
 
-        serv->acceptor_loop.call([this, type, &sts](){
+        loop.call([this, &type, &sts](){
             if(auto oper = op.lock())
                 oper->doReply(type, sts);
         });
@@ -105,7 +106,7 @@ struct ServerIntrospectControl : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
@@ -116,6 +117,7 @@ struct ServerIntrospectControl : public server::ConnectOp
     virtual void onPut(std::function<void(std::unique_ptr<server::ExecOp>&& fn, Value&&)>&& fn) override final {}
 
     const std::weak_ptr<server::Server::Pvt> server;
+    const evbase loop;
     const std::weak_ptr<ServerIntrospect> op;
 
     INST_COUNTER(ServerIntrospectControl);
@@ -5,7 +5,9 @@
  */
 
 #include <cassert>
+#include <cstring>
 
+#include <algorithm>
 #include <deque>
 
 #include <epicsMutex.h>
@@ -24,6 +26,81 @@ namespace {
 
 typedef epicsGuard<epicsMutex> Guard;
 
+/* Serialize a monitor update.  When the same Value is also queued for other subscribers
+ * (eg. by SharedPV::post()), the encoding is cached and re-used by all subscribers with
+ * the same type, pvMask, and byte order.
+ */
+void to_wire_shared(Buffer& buf, Value& val, const BitMask& mask)
+{
+    auto& store = Value::Helper::store(val);
+    if(store.use_count()<=1) {
+        // only queued for this subscriber
+        to_wire_valid(buf, val, &mask);
+        return;
+    }
+
+    auto top = store->top();
+    auto cache(std::atomic_load(&top->wirecache));
+    if(!cache) {
+        auto fresh(std::make_shared<WireCache>());
+        // on failure, another worker has already created, and cache is updated
+        if(std::atomic_compare_exchange_strong(&top->wirecache, &cache, fresh))
+            cache = std::move(fresh);
+    }
+
+    const auto desc = Value::Helper::desc(val);
+
+    shared_array<const void> bytes;
+    {
+        Guard G(cache->lock);
+
+        bool found = false;
+        for(auto& cur : cache->entries) {
+            if(cur.desc==desc && cur.be==buf.be && cur.mask==mask) {
+                bytes = cur.bytes;
+                found = true;
+                break;
+            }
+        }
+
+        if(!found) {
+            auto backing(std::make_shared<std::vector<uint8_t>>());
+            VectorOutBuf E(buf.be, *backing);
+            to_wire_valid(E, val, &mask);
+            if(!E.good()) {
+                buf.fault(__FILE__, __LINE__);
+                return;
+            }
+            backing->resize(E.consumed());
+            bytes = shared_array<const uint8_t>(backing, backing->data(), backing->size()).castTo<const void>();
+
+            cache->entries.emplace_back();
+            auto& ent = cache->entries.back();
+            ent.desc = desc;
+            ent.mask = static_cast<const detail::BitBase<BitMask>&>(mask); // explicit copy
+            ent.be = buf.be;
+            ent.bytes = bytes;
+        }
+    }
+
+    // large encodings are appended by reference
+    if(buf.addRef(bytes, bytes.size()))
+        return;
+
+    auto src = static_cast<const uint8_t*>(bytes.data());
+    for(size_t nremain = bytes.size(); nremain;) {
+        if(!buf.ensure(1u)) {
+            buf.fault(__FILE__, __LINE__);
+            break;
+        }
+        size_t nbytes = std::min(buf.size(), nremain);
+        memcpy(buf.save(), src, nbytes);
+        buf._skip(nbytes);
+        src += nbytes;
+        nremain -= nbytes;
+    }
+}
+
 struct MonitorOp : public ServerOp,
                    public std::enable_shared_from_this<MonitorOp>
 {
@@ -32,7 +109,7 @@ struct MonitorOp : public ServerOp,
     {}
     virtual ~MonitorOp() {}
 
-    // only access from accepter worker thread
+    // only access from connection worker thread
     std::function<void(bool)> onStart;
     std::function<void()> onLowMark;
     std::function<void()> onHighMark;
@@ -42,7 +119,7 @@ struct MonitorOp : public ServerOp,
     BitMask pvMask;
     std::string msg;
 
-    // Further members can only be changed from the accepter worker thread with this lock held.
+    // Further members can only be changed from the connection worker thread with this lock held.
     // They may be read from the worker, or if this lock is held.
     mutable epicsMutex lock;
 
@@ -60,27 +137,20 @@ struct MonitorOp : public ServerOp,
     // caller must hold lock.
     // only used after State==Idle
     static
-    void maybeReply(server::Server::Pvt* server, const std::shared_ptr<MonitorOp>& op)
+    void maybeReply(const std::shared_ptr<MonitorOp>& op)
     {
         // can we send a reply?
         if(!op->scheduled && op->state==Executing && !op->queue.empty() && (!op->pipeline || op->window))
         {
             // based on operation state, yes
-            server->acceptor_loop.dispatch([op](){
-                auto ch(op->chan.lock());
-                if(!ch)
-                    return;
-                auto conn(ch->conn.lock());
-                if(!conn)
-                    return;
+            auto ch(op->chan.lock());
+            if(!ch)
+                return;
+            auto conn(ch->conn.lock());
+            if(!conn)
+                return;
 
-                if(conn->bev && (bufferevent_get_enabled(conn->bev.get())&EV_READ)) {
-                    op->doReply();
-                } else {
-                    // connection TX queue is too full
-                    conn->backlog.push_back(std::bind(&MonitorOp::doReply, op));
-                }
-            });
+            conn->readyReply(op);
 
             op->scheduled = true;
         }
@@ -129,13 +199,13 @@ struct MonitorOp : public ServerOp,
 
                 } else {
                     to_wire(R, Status{});
-                    to_wire(R, type.get());
+                    to_wire(R, type, conn->txRegistry);
                 }
 
             } else if(!queue.empty()) {
                 auto& ent = queue.front();
                 if(ent) {
-                    to_wire_valid(R, ent, &pvMask);
+                    to_wire_shared(R, ent, pvMask);
                     // TODO: placeholder for overrun mask
                     to_wire(R, uint8_t(0u));
 
@@ -157,7 +227,7 @@ struct MonitorOp : public ServerOp,
                 conn->opByIOID.erase(it);
 
                 if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
+                    conn->worker->loop.dispatch([self](){
                         self->onClose("");
                     });
 
@@ -178,7 +248,7 @@ struct MonitorOp : public ServerOp,
             bool after = window <= low;
 
             if(before && after && onLowMark) {
-                conn->iface->server->acceptor_loop.dispatch([self]() {
+                conn->worker->loop.dispatch([self]() {
                     if(self->onLowMark)
                         self->onLowMark();
                 });
@@ -189,13 +259,16 @@ struct MonitorOp : public ServerOp,
             // reschedule myself
             assert(!scheduled); // we've been holding the lock, so this should not have changed
 
-            conn->iface->server->acceptor_loop.dispatch([self]() {
-                self->doReply();
-            });
+            conn->readyReply(self);
             scheduled = true;
         }
     }
 
+    void sendReply() override final
+    {
+        doReply();
+    }
+
     void show(std::ostream& strm) const override final
     {
         strm<<"MONITOR\n";
@@ -236,7 +309,16 @@ struct ServerMonitorControl : public server::MonitorControlOp
                 // squash
                 assert(mon->limit>0 && !mon->queue.empty());
 
-                mon->queue.back().assign(val);
+                auto& last = mon->queue.back();
+                auto& store = Value::Helper::store(last);
+                if(store.use_count()>1) {
+                    // also queued for other subscribers, which must not see this change.
+                    last = last.clone();
+                } else if(store) {
+                    // any cached encoding will no longer be valid
+                    std::atomic_store(&store->top()->wirecache, std::shared_ptr<WireCache>());
+                }
+                last.assign(val);
                 // TODO track overrun
 
             } else {
@@ -244,7 +326,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
             }
 
             if(auto serv = server.lock())
-                MonitorOp::maybeReply(serv.get(), mon);
+                MonitorOp::maybeReply(mon);
         }
 
         return mon->queue.size() < mon->limit;
@@ -275,7 +357,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, low, high](){
+        loop.call([this, low, high](){
             if(auto oper = op.lock()) {
                 Guard G(oper->lock);
                 oper->low = low;
@@ -289,7 +371,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onStart = std::move(fn);
         });
@@ -299,7 +381,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onHighMark = std::move(fn);
         });
@@ -309,13 +391,14 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onLowMark = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    const evbase loop;
     const std::weak_ptr<MonitorOp> op;
 
     INST_COUNTER(ServerMonitorControl);
@@ -329,6 +412,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
                      const Value& request,
                      const std::weak_ptr<MonitorOp>& op)
         :server(server)
+        ,loop(conn->worker->loop.internal())
         ,op(op)
     {
         _op = Info;
@@ -352,7 +436,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return ret;
-        serv->acceptor_loop.call([this, &type, &ret, &mask](){
+        loop.call([this, &type, &ret, &mask](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
@@ -374,7 +458,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating) {
                     oper->msg = msg;
@@ -388,13 +472,14 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    const evbase loop;
     const std::weak_ptr<MonitorOp> op;
 
     INST_COUNTER(ServerMonitorSetup);
@@ -406,6 +491,7 @@ ServerMonitorControl::ServerMonitorControl(ServerMonitorSetup* setup,
                                            const std::string& name,
                                            const std::weak_ptr<MonitorOp>& op)
     :server(server)
+    ,loop(setup->loop)
     ,op(op)
 {
     _op = Info;
@@ -541,7 +627,7 @@ void ServerConn::handle_MONITOR()
             bool after = op->window > op->high;
 
             if(!before && after && op->onHighMark) {
-                iface->server->acceptor_loop.dispatch([op](){
+                worker->loop.dispatch([op](){
                     if(op->onHighMark)
                         op->onHighMark();
                 });
@@ -564,7 +650,7 @@ void ServerConn::handle_MONITOR()
 
             {
                 Guard G(op->lock);
-                MonitorOp::maybeReply(iface->server, op);
+                MonitorOp::maybeReply(op);
             }
         }
 
@@ -578,7 +664,7 @@ void ServerConn::handle_MONITOR()
                 opByIOID.erase(it);
 
                 if(self->onClose) {
-                    iface->server->acceptor_loop.dispatch([self](){
+                    worker->loop.dispatch([self](){
                         if(self->onClose)
                             self->onClose("");
                     });
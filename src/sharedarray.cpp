@@ -13,6 +13,7 @@
 #include <pvxs/sharedArray.h>
 #include <pvxs/data.h>
 #include "utilpvt.h"
+#include "arrayops.h"
 
 namespace pvxs {
 
@@ -166,6 +167,19 @@ void convertCast(const void *sbase, void *dbase, size_t count)
         D[i] = Dest(S[i]);
 }
 
+// common numeric conversions with vectorized implementations
+#define CASE(SRC, DEST) \
+template<> \
+void convertCast<SRC, DEST>(const void *sbase, void *dbase, size_t count) \
+{ \
+    impl::convertArray(static_cast<DEST*>(dbase), static_cast<const SRC*>(sbase), count); \
+}
+CASE(int32_t, double)
+CASE(double, int32_t)
+CASE(float, double)
+CASE(double, float)
+#undef CASE
+
 void printValue(std::string& dest, const bool& src)
 {
     dest = src ? "true" : "false";
@@ -433,8 +447,8 @@ void convertArr(ArrayType dtype,       void *dbase,
         case ArrayType::UInt32: convertCast<double, int32_t>(sbase, dbase, count); return;
         case ArrayType::Int64:
         case ArrayType::UInt64: convertCast<double, int64_t>(sbase, dbase, count); return;
-        case ArrayType::Float32:memcpy(dbase, sbase, count*sizeof(double)); return;
-        case ArrayType::Float64:convertCast<double, double>(sbase, dbase, count); return;
+        case ArrayType::Float32:convertCast<double, float>(sbase, dbase, count); return;
+        case ArrayType::Float64:memcpy(dbase, sbase, count*sizeof(double)); return;
         case ArrayType::String: convertToStr<double>(sbase, dbase, count); return;
         case ArrayType::Value:
         case ArrayType::Null: break; // no convert
@@ -6,6 +6,7 @@
 
 #include <set>
 #include <map>
+#include <atomic>
 
 #include <epicsTime.h>
 #include <epicsMutex.h>
@@ -466,12 +467,119 @@ Value SharedPV::fetch() const
     }
 }
 
+namespace {
+/* Counting bloom filter of PV names.
+ * Lookups take no lock.  Updates are serialized by StaticSource::Impl::lock.
+ */
+struct NameFilter {
+    static constexpr unsigned nhash = 4u;
+    // grow when there are fewer counters per name.  ~2% false positives.
+    static constexpr size_t minPerName = 8u;
+
+    struct Table {
+        const size_t mask;
+        std::unique_ptr<std::atomic<uint8_t>[]> counts;
+        explicit Table(size_t size)
+            :mask(size-1u)
+            ,counts(new std::atomic<uint8_t>[size])
+        {
+            for(auto i : range(size))
+                counts[i].store(0u, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<const Table*> current{nullptr};
+    // a concurrent lookup may still be using a replaced Table, so all are kept.
+    // As each is twice the size of the last, this at most doubles memory use.
+    std::vector<std::unique_ptr<Table>> tables;
+    size_t count = 0u;
+
+    // FNV-1a
+    static uint64_t hash(const char *name)
+    {
+        uint64_t H = 0xcbf29ce484222325ull;
+        for(; *name; name++) {
+            H ^= uint8_t(*name);
+            H *= 0x100000001b3ull;
+        }
+        return H;
+    }
+
+    template<typename Fn>
+    static void foreach(const Table& T, const char *name, Fn&& fn)
+    {
+        auto H = hash(name);
+        auto step = (H>>32u) | 1u;
+        for(auto i : range(nhash)) {
+            fn(T.counts[(H + i*step) & T.mask]);
+        }
+    }
+
+    bool mayContain(const char *name) const
+    {
+        auto T = current.load(std::memory_order_acquire);
+        if(!T)
+            return false;
+        bool ret = true;
+        foreach(*T, name, [&ret](const std::atomic<uint8_t>& C) {
+            ret &= C.load(std::memory_order_relaxed)!=0u;
+        });
+        return ret;
+    }
+
+    static void inc(Table& T, const char *name)
+    {
+        foreach(T, name, [](std::atomic<uint8_t>& C) {
+            auto c = C.load(std::memory_order_relaxed);
+            if(c!=0xffu) // saturate
+                C.store(c+1u, std::memory_order_relaxed);
+        });
+    }
+
+    void add(const std::string& name, const StaticSource::list_t& pvs)
+    {
+        count++;
+        if(!tables.empty() && (tables.back()->mask+1u)/minPerName >= count) {
+            inc(*tables.back(), name.c_str());
+            return;
+        }
+
+        // (re)build with twice the minimum size
+        size_t size = 1024u;
+        while(size < 2u*minPerName*count)
+            size <<= 1u;
+
+        std::unique_ptr<Table> T(new Table(size));
+        for(auto& pair : pvs)
+            inc(*T, pair.first.c_str());
+        current.store(T.get(), std::memory_order_release);
+        tables.push_back(std::move(T));
+    }
+
+    void remove(const std::string& name)
+    {
+        count--;
+        foreach(*tables.back(), name.c_str(), [](std::atomic<uint8_t>& C) {
+            auto c = C.load(std::memory_order_relaxed);
+            if(c!=0xffu) // a saturated count is never decremented
+                C.store(c-1u, std::memory_order_relaxed);
+        });
+    }
+};
+} // namespace
+
 struct StaticSource::Impl : public Source
 {
     mutable RWLock lock;
 
     list_t pvs;
     decltype (List::names) list;
+    NameFilter filter;
+
+    virtual bool mayClaim(const char* name) const override final
+    {
+        return filter.mayContain(name);
+    }
 
     virtual void onSearch(Search &op) override
     {
@@ -574,6 +682,7 @@ StaticSource& StaticSource::add(const std::string& name, const SharedPV &pv)
         throw std::logic_error("add() will not create duplicate PV");
 
     impl->pvs[name] = pv;
+    impl->filter.add(name, impl->pvs);
     impl->list.reset();
 
     return *this;
@@ -593,6 +702,7 @@ StaticSource& StaticSource::remove(const std::string& name)
             return *this;
         pv = it->second;
         impl->pvs.erase(it);
+        impl->filter.remove(name);
         impl->list.reset();
     }
 
@@ -5,7 +5,11 @@
  */
 
 #include <cstring>
+#include <unordered_map>
+
 #include <epicsAssert.h>
+#include <epicsGuard.h>
+#include <epicsThread.h>
 
 #include "dataimpl.h"
 #include "utilpvt.h"
@@ -38,6 +42,8 @@ struct Member::Helper {
     static
     void copy_tree(const FieldDesc* desc, Member& node);
     static
+    bool column_tree(const FieldDesc* desc, Member& node);
+    static
     void show_Node(std::ostream& strm, const std::string& name, const Member* node);
 };
 
@@ -270,45 +276,77 @@ void Member::Helper::build_tree(std::vector<FieldDesc>& desc, const Member& node
         if(code.code==TypeCode::Struct)
             child.parent_index = cindex-cref;
 
-        fld.mlookup[cnode.name] = cindex-cref;
+        fld.mlookup.add(cnode.name, cindex-cref);
         fld.miter.emplace_back(cnode.name, cindex-cref);
 
         std::string cname = cnode.name+".";
         if(fld.code.code==TypeCode::Struct && fld.code==child.code) {
             // propagate names from sub-struct
             for(auto& cpair : child.mlookup) {
-                fld.mlookup[cname+cpair.first] = cindex-cref+cpair.second;
+                fld.mlookup.add(cname+cpair.first, cindex-cref+cpair.second);
             }
         }
     }
 
+    desc[index].mlookup.sort();
+
     assert(desc.size()==index+desc[index].size());
 }
 
 TypeDef::TypeDef(std::shared_ptr<const Member>&& temp)
 {
-    auto tempdesc = std::make_shared<std::vector<FieldDesc>>();
-    Member::Helper::build_tree(*tempdesc, *temp);
-
-    std::shared_ptr<const FieldDesc> type(tempdesc, tempdesc->data()); // alias
+    std::vector<FieldDesc> tempdesc;
+    Member::Helper::build_tree(tempdesc, *temp);
 
     top = std::move(temp);
-    desc = std::move(type);
+    desc = intern(std::move(tempdesc));
 }
 
 void Member::Helper::copy_tree(const FieldDesc* desc, Member& node)
 {
     node.code = desc->code;
     node.id = desc->id;
+    if(desc->code==TypeCode::StructA || desc->code==TypeCode::UnionA) {
+        // members, and ID, are those of the element type
+        desc = &desc->members[0];
+        node.id = desc->id;
+    }
+    // Union member offsets are relative to members array
+    auto base = desc->code==TypeCode::Union ? desc->members.data() : desc;
     node.children.reserve(desc->miter.size());
     for(auto& pair : desc->miter) {
-        auto cdesc = desc+pair.second;
+        auto cdesc = base+pair.second;
         node.children.emplace_back(cdesc->code, pair.first);
         node.children.back().id = cdesc->id;
         copy_tree(cdesc, node.children.back());
     }
 }
 
+// Column-wise form of a Struct[] element type.  Replace each leaf with an array of the leaf type.
+bool Member::Helper::column_tree(const FieldDesc* desc, Member& node)
+{
+    node.children.reserve(desc->miter.size());
+    for(auto& pair : desc->miter) {
+        auto cdesc = desc+pair.second;
+        switch(cdesc->code.code) {
+#define CASE(CODE, TYPE, STORE) case TypeCode::CODE:
+        COLUMN_TYPES(CASE)
+#undef CASE
+            node.children.emplace_back(cdesc->code.arrayOf(), pair.first);
+            break;
+        case TypeCode::Struct:
+            node.children.emplace_back(cdesc->code, pair.first);
+            node.children.back().id = cdesc->id;
+            if(!column_tree(cdesc, node.children.back()))
+                return false;
+            break;
+        default:
+            return false; // Union, Any, or array.  Not representable
+        }
+    }
+    return true;
+}
+
 TypeDef::TypeDef(const Value& val)
 {
     if(val.desc) {
@@ -317,13 +355,11 @@ TypeDef::TypeDef(const Value& val)
 
         Member::Helper::copy_tree(val.desc, *root);
 
-        auto temp = std::make_shared<std::vector<FieldDesc>>();
-        Member::Helper::build_tree(*temp, *root);
-
-        std::shared_ptr<const FieldDesc> type(temp, temp->data()); // alias
+        std::vector<FieldDesc> temp;
+        Member::Helper::build_tree(temp, *root);
 
         top = std::move(root);
-        desc = std::move(type);
+        desc = intern(std::move(temp));
     }
 }
 
@@ -382,13 +418,11 @@ void TypeDef::_append(Member& node, const Member& adopt)
 
 void TypeDef::_append_finish(std::shared_ptr<Member>&& edit)
 {
-    auto temp = std::make_shared<std::vector<FieldDesc>>();
-    Member::Helper::build_tree(*temp, *edit);
-
-    std::shared_ptr<const FieldDesc> type(temp, temp->data()); // alias
+    std::vector<FieldDesc> temp;
+    Member::Helper::build_tree(temp, *edit);
 
     top = std::move(edit);
-    desc = std::move(type);
+    desc = intern(std::move(temp));
 }
 
 Value TypeDef::create() const
@@ -435,6 +469,165 @@ std::ostream& operator<<(std::ostream& strm, const TypeDef& def)
 
 namespace impl {
 
+namespace {
+
+typedef epicsGuard<epicsMutex> Guard;
+
+inline void hashCombine(size_t& hash, size_t val)
+{
+    hash ^= val + 0x9e3779b9u + (hash<<6u) + (hash>>2u);
+}
+
+size_t hashTree(const FieldDesc* desc, size_t count)
+{
+    std::hash<std::string> strhash;
+    size_t ret = count;
+    for(auto i : range(count)) {
+        auto& fld = desc[i];
+        hashCombine(ret, size_t(fld.code.code));
+        hashCombine(ret, strhash(fld.id));
+        for(auto& pair : fld.miter) {
+            hashCombine(ret, strhash(pair.first));
+            hashCombine(ret, pair.second);
+        }
+        if(!fld.members.empty())
+            hashCombine(ret, hashTree(fld.members.data(), fld.members.size()));
+    }
+    return ret;
+}
+
+// also compare IDs, which Value::equalType() ignores
+bool equalTree(const std::vector<FieldDesc>& A, const std::vector<FieldDesc>& B)
+{
+    if(A.size()!=B.size())
+        return false;
+
+    for(auto i : range(A.size())) {
+        auto& a = A[i];
+        auto& b = B[i];
+        if(a.code!=b.code || a.id!=b.id || a.miter!=b.miter || !equalTree(a.members, b.members))
+            return false;
+    }
+    return true;
+}
+
+struct InternTable {
+    epicsMutex lock;
+    // hash -> (tree, weak ref. to tree)
+    std::unordered_multimap<size_t, std::pair<const std::vector<FieldDesc>*,
+                                              std::weak_ptr<const std::vector<FieldDesc>>>> types;
+};
+
+InternTable* intern_table;
+epicsThreadOnceId intern_once = EPICS_THREAD_ONCE_INIT;
+
+void intern_init(void *unused)
+{
+    (void)unused;
+    intern_table = new InternTable;
+}
+
+struct InternDeleter {
+    size_t hash;
+    void operator()(const std::vector<FieldDesc>* descs) {
+        {
+            Guard G(intern_table->lock);
+            auto range = intern_table->types.equal_range(hash);
+            for(auto it = range.first; it!=range.second; ++it) {
+                if(it->second.first==descs) {
+                    intern_table->types.erase(it);
+                    break;
+                }
+            }
+        }
+        delete descs;
+    }
+};
+
+// Find Struct[] which may be stored column-wise, and attach the column type
+void set_columns(std::vector<FieldDesc>& descs)
+{
+    for(auto& fld : descs) {
+        if(fld.code==TypeCode::StructA) {
+            auto elem = &fld.members[0];
+            Member root(TypeCode::Struct, "", elem->id, {});
+
+            if(Member::Helper::column_tree(elem, root)) {
+                std::vector<FieldDesc> temp;
+                Member::Helper::build_tree(temp, root);
+
+                // need at least one column to know the number of elements
+                if(std::any_of(temp.begin(), temp.end(), [](const FieldDesc& cfld) {
+                               return cfld.code!=TypeCode::Struct;
+                }))
+                    fld.columns = intern(std::move(temp));
+            }
+        }
+        set_columns(fld.members);
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const FieldDesc> intern(std::vector<FieldDesc>&& descs)
+{
+    if(descs.empty())
+        return nullptr;
+
+    epicsThreadOnce(&intern_once, &intern_init, nullptr);
+
+    set_columns(descs);
+
+    const auto hash = hashTree(descs.data(), descs.size());
+
+    // hold references found during search until after unlock,
+    // as releasing the last reference would re-enter to remove from intern_table
+    std::vector<std::shared_ptr<const std::vector<FieldDesc>>> found;
+
+    Guard G(intern_table->lock);
+
+    auto range = intern_table->types.equal_range(hash);
+    for(auto it = range.first; it!=range.second; ++it) {
+        if(auto existing = it->second.second.lock()) {
+            found.push_back(existing);
+            if(equalTree(*existing, descs))
+                return std::shared_ptr<const FieldDesc>(existing, existing->data()); // alias
+        }
+    }
+
+    std::shared_ptr<const std::vector<FieldDesc>> fresh(new std::vector<FieldDesc>(std::move(descs)),
+                                                        InternDeleter{hash});
+    intern_table->types.emplace(hash, std::make_pair(fresh.get(), fresh));
+
+    return std::shared_ptr<const FieldDesc>(fresh, fresh->data()); // alias
+}
+
+size_t internedCount()
+{
+    epicsThreadOnce(&intern_once, &intern_init, nullptr);
+    Guard G(intern_table->lock);
+    return intern_table->types.size();
+}
+
+void FieldIndex::sort()
+{
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const value_type& lhs, const value_type& rhs) {
+                         return lhs.first < rhs.first;
+                     });
+    // of duplicates, keep the last
+    auto out = entries.begin();
+    for(auto it = entries.begin(), end = entries.end(); it!=end; ++it) {
+        if(it+1!=end && it->first==(it+1)->first)
+            continue;
+        if(out!=it)
+            *out = std::move(*it);
+        ++out;
+    }
+    entries.erase(out, entries.end());
+    entries.shrink_to_fit();
+}
+
 void show_FieldDesc(std::ostream& strm, const FieldDesc* desc)
 {
     for(auto idx : range(desc->size())) {
@@ -445,7 +638,6 @@ void show_FieldDesc(std::ostream& strm, const FieldDesc* desc)
 
         switch(fld.code.code) {
         case TypeCode::Struct:
-            // note: need to ensure stable lexical iteration order if fld.mlookup ever becomes unordered_map
             for(auto& pair : fld.mlookup) {
                 strm<<indent{}<<"    "<<pair.first<<" -> "<<pair.second<<" ["<<(idx+pair.second)<<"]\n";
             }
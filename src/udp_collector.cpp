@@ -41,7 +41,7 @@ struct UDPCollector : public UDPManager::Search,
     evevent rx;
     uint32_t prevndrop{};
 
-    std::vector<uint8_t> buf;
+    UDPRxBatch batch;
 
     UDPManager::Beacon beaconMsg;
 
@@ -50,21 +50,19 @@ struct UDPCollector : public UDPManager::Search,
     UDPCollector(UDPManager::Pvt* manager, const SockAddr& bind_addr);
     ~UDPCollector();
 
-    bool handle_one()
+    // receive up to one batch.  returns false when there is nothing more to read (for now)
+    bool handle_batch()
     {
-        osiSocklen_t alen = src.size();
         uint32_t ndrop = 0u;
 
-        // For Search messages, we use PV name strings in-place by adding nils.
-        // Ensure one extra byte at the end of the buffer for a nil after the last PV name
-        const int nrx = recvfromx(sock.sock, (char*)&buf[0], buf.size()-1, &src->sa, &alen, &ndrop);
+        const int nmsg = batch.recv(sock.sock, &ndrop);
 
-        if(nrx>=0 && ndrop!=0u && prevndrop!=ndrop) {
+        if(nmsg>=0 && ndrop!=0u && prevndrop!=ndrop) {
             log_debug_printf(logio, "UDP collector socket buffer overflowed %u -> %u\n", unsigned(prevndrop), unsigned(ndrop));
             prevndrop = ndrop;
         }
 
-        if(nrx<0) {
+        if(nmsg<0) {
             int err = evutil_socket_geterror(sock.sock);
             if(err==SOCK_EWOULDBLOCK || err==EAGAIN || err==SOCK_EINTR) {
                 // nothing to do here
@@ -73,13 +71,30 @@ struct UDPCollector : public UDPManager::Search,
                            evutil_socket_error_to_string(err));
             }
             return false; // wait for more I/O
+        }
+
+        for(auto i : range(unsigned(nmsg))) {
+            process(batch[i]);
+        }
 
-        } else if(nrx<8) {
+        // a partial batch means the socket buffer is (momentarily) empty
+        return size_t(nmsg)==batch.size();
+    }
+
+    void process(UDPRxBatch::Msg& msg)
+    {
+        // For Search messages, we use PV name strings in-place by adding nils.
+        // UDPRxBatch leaves one extra byte at the end of the buffer for a nil after the last PV name
+        uint8_t * const buf = msg.buf;
+        const size_t nrx = msg.len;
+        src = msg.src;
+
+        if(nrx<8) {
             // maybe a zero (body) length packet?
             // maybe an OS error?
 
             log_info_printf(logio, "UDP ignore runt on %s\n", name.c_str());
-            return true;
+            return;
 
         } else if(buf[0]!=0xca || buf[1]==0 || (buf[2]&(pva_flags::Control|pva_flags::SegMask))) {
             // minimum header size is 8 bytes
@@ -90,16 +105,16 @@ struct UDPCollector : public UDPManager::Search,
             log_info_printf(logio, "UDP ignore header%u %02x%02x%02x%02x on %s\n",
                        unsigned(nrx), buf[0], buf[1], buf[2], buf[3],
                     name.c_str());
-            return true;
+            return;
         }
 
-        log_hex_printf(logio, Level::Debug, &buf[0], nrx, "UDP Rx %d from %s\n", nrx, src.tostring().c_str());
+        log_hex_printf(logio, Level::Debug, &buf[0], nrx, "UDP Rx %u from %s\n", unsigned(nrx), src.tostring().c_str());
 
         names.clear();
 
         bool be = buf[2]&pva_flags::MSB;
 
-        FixedBuf M(be, buf.data(), nrx);
+        FixedBuf M(be, buf, nrx);
 
         uint8_t cmd = M[3];
 
@@ -111,7 +126,7 @@ struct UDPCollector : public UDPManager::Search,
             log_info_printf(logio, "UDP ignore header%u %02x%02x%02x%02x on %s\n",
                        unsigned(M.size()), M[0], M[1], M[2], M[3],
                     name.c_str());
-            return true;
+            return;
         }
 
         switch(cmd) {
@@ -211,8 +226,6 @@ struct UDPCollector : public UDPManager::Search,
         }
             break;
         }
-
-        return true;
     }
     void handle(short ev)
     {
@@ -220,8 +233,8 @@ struct UDPCollector : public UDPManager::Search,
         if(!(ev&EV_READ))
             return;
 
-        // handle up to 4 packets before going back to the reactor
-        for(unsigned i=0; i<4 && handle_one(); i++) {}
+        // handle up to 4 batches before going back to the reactor
+        for(unsigned i=0; i<4 && handle_batch(); i++) {}
     }
     static void handle_static(evutil_socket_t fd, short ev, void *raw)
     {
@@ -261,7 +274,8 @@ UDPCollector::UDPCollector(UDPManager::Pvt *manager, const SockAddr& bind_addr)
     ,bind_addr(bind_addr)
     ,sock(bind_addr.family(), SOCK_DGRAM, 0)
     ,rx(event_new(manager->loop.base, sock.sock, EV_READ|EV_PERSIST, &handle_static, this))
-    ,buf(0x10001)
+    // with recvmmsg(), several buffers amortize the syscall.  Otherwise one is enough.
+    ,batch(UDPRxBatch::native() ? 8u : 1u, 0x10000)
     ,beaconMsg(src)
 {
     manager->loop.assertInLoop();
@@ -306,6 +306,199 @@ int recvfromx(SOCKET sock, void *buf, size_t buflen, sockaddr* peer, osiSocklen_
 #endif
 }
 
+#if defined(__linux__) && (!defined(__GLIBC__) || __GLIBC__>2 || (__GLIBC__==2 && __GLIBC_MINOR__>=14))
+#  define HAVE_MMSG
+// cleared if the running kernel lacks recvmmsg()/sendmmsg()
+static std::atomic<bool> mmsgWorks{true};
+#endif
+
+#ifdef HAVE_MMSG
+struct UDPRxBatch::Pvt {
+    std::vector<mmsghdr> hdrs;
+    std::vector<iovec> iovs;
+    std::vector<char> cbufs;
+};
+struct UDPTxBatch::Pvt {
+    std::vector<mmsghdr> hdrs;
+    std::vector<iovec> iovs;
+};
+#else
+struct UDPRxBatch::Pvt {};
+struct UDPTxBatch::Pvt {};
+#endif
+
+UDPRxBatch::UDPRxBatch(size_t count, size_t capacity)
+    :cap(capacity)
+    ,storage(new uint8_t[count*(capacity+1u)])
+    ,msgs(count)
+    ,pvt(new Pvt)
+{
+    if(!count || !capacity)
+        throw std::invalid_argument("UDPRxBatch must have non-zero size");
+
+    for(auto i : range(count))
+        msgs[i].buf = storage.get() + i*(capacity+1u);
+
+#ifdef HAVE_MMSG
+    pvt->hdrs.resize(count);
+    pvt->iovs.resize(count);
+#  ifdef SO_RXQ_OVFL
+    pvt->cbufs.resize(count*CMSG_SPACE(4u));
+#  endif
+#endif
+}
+
+UDPRxBatch::~UDPRxBatch() {}
+
+bool UDPRxBatch::native()
+{
+#ifdef HAVE_MMSG
+    return mmsgWorks.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+int UDPRxBatch::recv(SOCKET sock, uint32_t *ndrop)
+{
+#ifdef HAVE_MMSG
+    if(mmsgWorks.load(std::memory_order_relaxed)) {
+        auto& hdrs = pvt->hdrs;
+        const size_t cstep = pvt->cbufs.size()/msgs.size();
+
+        for(auto i : range(msgs.size())) {
+            auto& M = msgs[i];
+            M.src = SockAddr();
+            pvt->iovs[i].iov_base = M.buf;
+            pvt->iovs[i].iov_len = cap;
+
+            auto& hdr = hdrs[i].msg_hdr;
+            hdr = msghdr{};
+            hdr.msg_iov = &pvt->iovs[i];
+            hdr.msg_iovlen = 1u;
+            hdr.msg_name = &M.src->sa;
+            hdr.msg_namelen = M.src.size();
+            if(cstep) {
+                hdr.msg_control = &pvt->cbufs[i*cstep];
+                hdr.msg_controllen = cstep;
+            }
+            hdrs[i].msg_len = 0u;
+        }
+
+        int ret = recvmmsg(sock, hdrs.data(), hdrs.size(), MSG_DONTWAIT, nullptr);
+
+        if(ret<0 && errno==ENOSYS) {
+            log_warn_printf(log, "recvmmsg() not supported.  Fall back to recvmsg()%s\n", "");
+            mmsgWorks = false;
+
+        } else {
+            for(auto i : range(ret<0 ? 0u : unsigned(ret))) {
+                auto& hdr = hdrs[i].msg_hdr;
+                msgs[i].len = hdrs[i].msg_len;
+
+                if(hdr.msg_flags & MSG_CTRUNC)
+                    log_debug_printf(log, "MSG_CTRUNC %zu, %zu\n", size_t(hdr.msg_controllen), cstep);
+
+#  ifdef SO_RXQ_OVFL
+                if(ndrop) {
+                    for(cmsghdr *C = CMSG_FIRSTHDR(&hdr); C ; C = CMSG_NXTHDR(&hdr, C)) {
+                        if(C->cmsg_level==SOL_SOCKET && C->cmsg_type==SO_RXQ_OVFL && C->cmsg_len>=CMSG_LEN(4u)) {
+                            memcpy(ndrop, CMSG_DATA(C), 4u);
+                        }
+                    }
+                }
+#  endif
+            }
+            return ret;
+        }
+    }
+#endif
+
+    int n = 0;
+    for(auto& M : msgs) {
+        M.src = SockAddr();
+        osiSocklen_t alen = M.src.size();
+        int ret = recvfromx(sock, M.buf, cap, &M.src->sa, &alen, ndrop);
+        if(ret<0)
+            return n ? n : -1; // leave errno/WSAGetLastError() for caller
+        M.len = ret;
+        n++;
+    }
+    return n;
+}
+
+UDPTxBatch::UDPTxBatch() :pvt(new Pvt) {}
+UDPTxBatch::~UDPTxBatch() {}
+
+void UDPTxBatch::push(const void *buf, size_t len, const SockAddr& dest)
+{
+    auto cbuf = static_cast<const uint8_t*>(buf);
+    msgs.push_back(Msg{dest, payload.size(), len, -1, 0});
+    payload.insert(payload.end(), cbuf, cbuf+len);
+}
+
+void UDPTxBatch::clear()
+{
+    payload.clear();
+    msgs.clear();
+}
+
+void UDPTxBatch::send(SOCKET sock)
+{
+    size_t i = 0u;
+
+#ifdef HAVE_MMSG
+    if(mmsgWorks.load(std::memory_order_relaxed)) {
+        auto& hdrs = pvt->hdrs;
+        auto& iovs = pvt->iovs;
+        hdrs.resize(msgs.size());
+        iovs.resize(msgs.size());
+
+        for(auto j : range(msgs.size())) {
+            auto& M = msgs[j];
+            iovs[j].iov_base = &payload[M.offset];
+            iovs[j].iov_len = M.len;
+
+            auto& hdr = hdrs[j].msg_hdr;
+            hdr = msghdr{};
+            hdr.msg_iov = &iovs[j];
+            hdr.msg_iovlen = 1u;
+            hdr.msg_name = &M.dest->sa;
+            hdr.msg_namelen = M.dest.size();
+            hdrs[j].msg_len = 0u;
+        }
+
+        while(i < msgs.size()) {
+            int ret = sendmmsg(sock, &hdrs[i], msgs.size()-i, 0);
+            if(ret<0 && errno==ENOSYS && i==0u) {
+                log_warn_printf(log, "sendmmsg() not supported.  Fall back to sendto()%s\n", "");
+                mmsgWorks = false;
+                break;
+
+            } else if(ret<0) {
+                // error is for the first unsent datagram.  skip it and continue with the remainder
+                msgs[i].ntx = -1;
+                msgs[i].err = evutil_socket_geterror(sock);
+                i++;
+
+            } else {
+                for(auto j : range(size_t(ret))) {
+                    msgs[i+j].ntx = hdrs[i+j].msg_len;
+                    msgs[i+j].err = 0;
+                }
+                i += ret;
+            }
+        }
+    }
+#endif
+
+    for(; i < msgs.size(); i++) {
+        auto& M = msgs[i];
+        M.ntx = sendto(sock, (char*)&payload[M.offset], M.len, 0, &M.dest->sa, M.dest.size());
+        M.err = M.ntx<0 ? evutil_socket_geterror(sock) : 0;
+    }
+}
+
 SockAddr::SockAddr(int af)
 {
     memset(&store, 0, sizeof(store));
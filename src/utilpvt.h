@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
 #include <event2/util.h>
 
@@ -260,6 +261,73 @@ public:
 PVXS_API
 std::ostream& operator<<(std::ostream& strm, const SockAddr& addr);
 
+//! Receive several datagrams at once.
+//! With one recvmmsg() where supported (Linux), otherwise one recvfromx() for each.
+class PVXS_API UDPRxBatch {
+public:
+    struct Msg {
+        uint8_t *buf; // capacity()+1 bytes.  recv() never writes the last, which is left for a trailing nil.
+        size_t len;   // bytes received
+        SockAddr src;
+    };
+
+    UDPRxBatch(size_t count, size_t capacity);
+    ~UDPRxBatch();
+    UDPRxBatch(const UDPRxBatch&) = delete;
+    UDPRxBatch& operator=(const UDPRxBatch&) = delete;
+
+    //! Receive up to size() datagrams without blocking.
+    //! Returns the number received.  Or -1 if none were because of an error, which may be EWOULDBLOCK.
+    int recv(SOCKET sock, uint32_t *ndrop);
+
+    inline size_t size() const { return msgs.size(); }
+    inline size_t capacity() const { return cap; }
+    inline Msg& operator[](size_t i) { return msgs[i]; }
+
+    //! True if recv() makes one system call for a batch.
+    static bool native();
+
+    struct Pvt;
+private:
+    const size_t cap;
+    std::unique_ptr<uint8_t[]> storage;
+    std::vector<Msg> msgs;
+    std::unique_ptr<Pvt> pvt;
+};
+
+//! Send several datagrams at once.
+//! With sendmmsg() where supported (Linux), otherwise one sendto() for each.
+class PVXS_API UDPTxBatch {
+public:
+    struct Msg {
+        SockAddr dest;
+        size_t offset, len; // payload
+        int ntx; // bytes sent, or -1 on error
+        int err; // when ntx<0
+    };
+
+    UDPTxBatch();
+    ~UDPTxBatch();
+    UDPTxBatch(const UDPTxBatch&) = delete;
+    UDPTxBatch& operator=(const UDPTxBatch&) = delete;
+
+    //! Queue a copy of a datagram
+    void push(const void *buf, size_t len, const SockAddr& dest);
+    //! Send all queued datagrams.  Afterward Msg::ntx and Msg::err give the result of each.
+    void send(SOCKET sock);
+    //! Forget queued datagrams and results
+    void clear();
+
+    inline size_t size() const { return msgs.size(); }
+    inline const Msg& operator[](size_t i) const { return msgs[i]; }
+
+    struct Pvt;
+private:
+    std::vector<uint8_t> payload;
+    std::vector<Msg> msgs;
+    std::unique_ptr<Pvt> pvt;
+};
+
 inline
 timeval totv(double t)
 {
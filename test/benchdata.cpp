@@ -14,16 +14,21 @@
 #include <pvxs/unittest.h>
 
 #include "pvaproto.h"
+#include "dataimpl.h"
+#include "arrayops.h"
 #include <utilpvt.h>
 
 #include <evhelper.h>
 
 #include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
 #include <epicsUnitTest.h>
 #include <testMain.h>
 
 namespace {
 using namespace pvxs;
+using namespace pvxs::impl;
 
 struct Sampler
 {
@@ -100,6 +105,312 @@ void benchAllocNTScalar()
     testShow()<<S;
 }
 
+void benchClone(size_t poolLimit)
+{
+    testDiag("%s(%u)", __func__, unsigned(poolLimit));
+
+    setValuePoolLimit(poolLimit);
+
+    constexpr size_t niter = 100000u;
+
+    Value proto(nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+    proto["value"] = 42.0;
+    proto["display.units"] = "arbitrary";
+
+    Value temp;
+
+    StopWatch W;
+    (void)W.click();
+    for(auto n : range(niter)) {
+        (void)n;
+        temp = proto.cloneEmpty();
+    }
+    auto tempty = W.click()/double(niter);
+
+    (void)W.click();
+    for(auto n : range(niter)) {
+        (void)n;
+        temp = proto.clone();
+    }
+    auto tclone = W.click()/double(niter);
+
+    testShow()<<" cloneEmpty() "<<tempty<<" ns  clone() "<<tclone<<" ns";
+    setValuePoolLimit(0u);
+}
+
+void benchAssign()
+{
+    testDiag("%s", __func__);
+
+    constexpr size_t niter = 100000u;
+
+    Value src(nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+    src["value"] = 42.0;
+    src["alarm.severity"] = 1;
+    src["timeStamp.secondsPastEpoch"] = 1234;
+    src["timeStamp.nanoseconds"] = 5678;
+    src["display.units"] = "arbitrary";
+
+    auto same(src.cloneEmpty());
+    TypeDef def(src);
+    def += {members::Int32("extra")};
+    auto similar(def.create());
+
+    StopWatch W;
+    (void)W.click();
+    for(auto n : range(niter)) {
+        (void)n;
+        same.assign(src);
+    }
+    auto tsame = W.click()/double(niter);
+
+    (void)W.click();
+    for(auto n : range(niter)) {
+        (void)n;
+        similar.assign(src);
+    }
+    auto tsimilar = W.click()/double(niter);
+
+    testShow()<<" same type "<<tsame<<" ns  similar type "<<tsimilar<<" ns";
+}
+
+// Struct[] of 50k elements.  Stored column-wise where possible.
+void benchTable(bool columnar)
+{
+    testDiag("%s(%s)", __func__, columnar ? "columns" : "elements");
+
+    constexpr size_t nrows = 50000u;
+
+    std::vector<Member> row({
+        members::Float64("x"),
+        members::Float64("y"),
+        members::Int32("id"),
+        members::String("name"),
+    });
+    if(!columnar)
+        row.push_back(members::Any("extra")); // prevents column-wise storage
+
+    TypeDef def(TypeCode::Struct, {
+                    members::StructA("table", "row_t", row),
+                });
+
+    StopWatch W;
+    Value val(def.create());
+    (void)W.click();
+    if(columnar) {
+        shared_array<double> x(nrows), y(nrows);
+        shared_array<int32_t> id(nrows);
+        shared_array<std::string> name(nrows);
+        for(auto i : range(nrows)) {
+            x[i] = i*1.5;
+            y[i] = i*0.5;
+            id[i] = int32_t(i);
+            name[i] = "row";
+        }
+        auto cols(val["table"].columns());
+        cols["x"] = x.freeze();
+        cols["y"] = y.freeze();
+        cols["id"] = id.freeze();
+        cols["name"] = name.freeze();
+        val["table"].assign(cols);
+
+    } else {
+        shared_array<Value> rows(nrows);
+        for(auto i : range(nrows)) {
+            rows[i] = val["table"].allocMember();
+            rows[i]["x"] = i*1.5;
+            rows[i]["y"] = i*0.5;
+            rows[i]["id"] = int32_t(i);
+            rows[i]["name"] = "row";
+        }
+        val["table"] = rows.freeze();
+    }
+    auto tbuild = W.click();
+
+    std::vector<uint8_t> bytes;
+    (void)W.click();
+    {
+        VectorOutBuf S(true, bytes);
+        to_wire_full(S, val);
+        bytes.resize(bytes.size()-S.size());
+    }
+    auto tencode = W.click();
+
+    Value dval(def.create());
+    if(columnar)
+        dval["table"].assign(dval["table"].columns()); // opt in to column-wise decode
+    TypeStore ctxt;
+    (void)W.click();
+    {
+        FixedBuf S(true, bytes);
+        from_wire_full(S, ctxt, dval);
+        if(!S.good() || !S.empty())
+            testFail("Decode error");
+    }
+    auto tdecode = W.click();
+
+    testShow()<<" build "<<tbuild/1e6<<" ms  encode "<<tencode/1e6<<" ms  decode "<<tdecode/1e6<<" ms  "
+              <<bytes.size()<<" bytes";
+}
+
+struct Encoder : public epicsThreadRunable
+{
+    const Value& val;
+    epicsEvent& start;
+    const size_t count;
+    epicsThread worker;
+    Encoder(const Value& val, epicsEvent& start, size_t count)
+        :val(val)
+        ,start(start)
+        ,count(count)
+        ,worker(*this, "encoder", epicsThreadGetStackSize(epicsThreadStackBig))
+    {
+        worker.start();
+    }
+
+    void run() override final {
+        start.wait();
+        start.signal(); // release next encoder
+        std::vector<uint8_t> wire;
+        for(size_t i=0; i<count; i++) {
+            wire.resize(1024u);
+            VectorOutBuf buf(true, wire);
+            to_wire_valid(buf, val);
+            if(!buf.good())
+                testFail("Encode error");
+        }
+    }
+};
+
+// all threads encode one (eg. posted) Value
+void benchSharedEncode(size_t nthreads)
+{
+    testDiag("%s(%zu)", __func__, nthreads);
+
+    constexpr size_t count = 100000u;
+
+    Value val(nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+    for(auto fld : val.iall()) {
+        if(fld.type()==TypeCode::Float64)
+            fld = 1.0;
+        else if(fld.type().kind()==Kind::Integer)
+            fld = 1;
+    }
+
+    epicsEvent start;
+    epicsUInt64 T0, T1;
+    {
+        std::vector<std::unique_ptr<Encoder>> encoders;
+        for(size_t i=0; i<nthreads; i++)
+            encoders.emplace_back(new Encoder(val, start, count));
+
+        T0 = epicsMonotonicGet();
+        start.signal();
+        // join encoders
+    }
+    T1 = epicsMonotonicGet();
+
+    double sec = (T1-T0)*1e-9;
+    testShow()<<" "<<nthreads<<" threads, "<<(count*nthreads/sec)<<" encode/sec.  "<<((T1-T0)/double(count))<<" ns/encode/thread";
+}
+
+void benchTypeBuild()
+{
+    testDiag("%s", __func__);
+
+    constexpr size_t niter = 1000u;
+
+    // a wide, table-like structure with nested sub-structures
+    std::vector<Member> cols;
+    for(auto i : range(64u)) {
+        cols.push_back(members::Float64A(SB()<<"column"<<i));
+    }
+    std::vector<Member> meta;
+    for(auto i : range(16u)) {
+        meta.push_back(members::Struct(SB()<<"meta"<<i, {
+                                           members::String("description"),
+                                           members::String("units"),
+                                           members::Int32("precision"),
+                                       }));
+    }
+    const TypeDef def(TypeCode::Struct, "epics:nt/NTTable:1.0", {
+                          members::StringA("labels"),
+                          members::Struct("value", cols),
+                          members::Struct("meta", meta),
+                      });
+    const auto proto(def.create());
+
+    std::vector<uint8_t> wire;
+    {
+        VectorOutBuf buf(true, wire);
+        to_wire(buf, Value::Helper::desc(proto));
+        wire.resize(wire.size()-buf.size());
+    }
+
+    Sampler Tdef, Tdes;
+    for(auto n : range(niter)) {
+        (void)n;
+        StopWatch W;
+
+        (void)W.click();
+        {
+            TypeDef temp(TypeCode::Struct, "epics:nt/NTTable:1.0", {
+                             members::StringA("labels"),
+                             members::Struct("value", cols),
+                             members::Struct("meta", meta),
+                         });
+            (void)temp.create();
+        }
+        Tdef.sample(W.click());
+
+        {
+            FixedBuf buf(true, wire);
+            TypeStore cache;
+            std::vector<FieldDesc> descs;
+            (void)W.click();
+            from_wire(buf, descs, cache);
+            Tdes.sample(W.click());
+            if(!buf.good() || descs.size()!=Value::Helper::desc(proto)->size())
+                testFail("Decode error");
+        }
+    }
+
+    testShow()<<" "<<Value::Helper::desc(proto)->size()<<" fields";
+    testShow()<<" TypeDef "<<Tdef;
+    testShow()<<" Decode  "<<Tdes;
+}
+
+void benchFieldLookup()
+{
+    testDiag("%s", __func__);
+
+    constexpr size_t niter = 100000u;
+
+    Value val(nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+    const FieldRef value(val, "value");
+    const FieldRef secs(val, "timeStamp.secondsPastEpoch");
+    const FieldRef units(val, "display.units");
+
+    uint64_t sum = 0u; // keep results alive
+
+    StopWatch W;
+    (void)W.click();
+    for(auto n : range(niter)) {
+        sum += val["value"].valid() + val["timeStamp.secondsPastEpoch"].valid() + val["display.units"].valid();
+        (void)n;
+    }
+    auto tstr = W.click()/double(3u*niter);
+
+    (void)W.click();
+    for(auto n : range(niter)) {
+        sum += val[value].valid() + val[secs].valid() + val[units].valid();
+        (void)n;
+    }
+    auto tref = W.click()/double(3u*niter);
+
+    testShow()<<" string "<<tstr<<" ns  FieldRef "<<tref<<" ns  x"<<tstr/tref<<" ("<<sum<<")";
+}
+
 template<typename E>
 void benchArraySerDes(bool be, const shared_array<const E>& arr)
 {
@@ -144,12 +455,97 @@ void benchArraySerDes(bool be, const shared_array<const E>& arr)
     testShow()<<" Des "<<Tdes;
 }
 
+// the per-element byte reversal used prior to arrayops.h
+void naiveSwap(void* dest, const void* src, size_t count, size_t esize)
+{
+    auto D = static_cast<uint8_t*>(dest);
+    auto S = static_cast<const uint8_t*>(src);
+    for(size_t i=0u; i<count*esize; i+=esize) {
+        for(size_t n=0u; n<esize; n++)
+            D[i + esize-1u-n] = S[i + n];
+    }
+}
+
+template<typename Dest, typename Src>
+void naiveConvert(Dest* dest, const Src* src, size_t count)
+{
+    for(size_t i=0u; i<count; i++)
+        dest[i] = Dest(src[i]);
+}
+
+template<typename Fn>
+Sampler benchKernel(size_t nbytes, Fn&& fn)
+{
+    // scale iterations to keep the total work roughly constant
+    const size_t niter = std::max(size_t(10u), size_t(64u*1024u*1024u)/std::max(size_t(1u), nbytes)/16u);
+
+    Sampler S;
+    for(auto n : range(niter)) {
+        (void)n;
+        StopWatch W;
+        (void)W.click();
+        fn();
+        S.sample(W.click());
+    }
+    return S;
+}
+
+void benchArrayOps()
+{
+    testDiag("%s() using %s", __func__, arrayOpsImpl());
+
+    for(size_t count : {16u, 1024u, 64u*1024u, 1024u*1024u}) {
+        std::vector<uint64_t> src(count), dest(count);
+        for(auto i : range(count))
+            src[i] = i;
+
+        for(size_t esize : {2u, 4u, 8u}) {
+            auto n = count*8u/esize;
+            auto naive = benchKernel(count*8u, [&]() { naiveSwap(dest.data(), src.data(), n, esize); });
+            auto fast = benchKernel(count*8u, [&]() { swapCopy(dest.data(), src.data(), n, esize); });
+            testShow()<<" swap"<<esize*8u<<" x"<<n<<" naive "<<naive.mean()<<" ns  swapCopy "<<fast.mean()
+                      <<" ns  x"<<naive.mean()/fast.mean();
+        }
+
+        std::vector<double> dsrc(count), ddest(count);
+        std::vector<int32_t> isrc(count), idest(count);
+        std::vector<float> fsrc(count), fdest(count);
+        for(auto i : range(count)) {
+            dsrc[i] = double(i)*0.5;
+            isrc[i] = int32_t(i);
+            fsrc[i] = float(i)*0.5f;
+        }
+
+#define BENCH(NAME, DEST, SRC) do { \
+            auto naive = benchKernel(count*8u, [&]() { naiveConvert(DEST.data(), SRC.data(), count); }); \
+            auto fast = benchKernel(count*8u, [&]() { convertArray(DEST.data(), SRC.data(), count); }); \
+            testShow()<<" " NAME " x"<<count<<" naive "<<naive.mean()<<" ns  convertArray "<<fast.mean() \
+                      <<" ns  x"<<naive.mean()/fast.mean(); \
+        } while(0)
+        BENCH("int32->double", ddest, isrc);
+        BENCH("double->int32", idest, dsrc);
+        BENCH("float->double", ddest, fsrc);
+        BENCH("double->float", fdest, dsrc);
+#undef BENCH
+    }
+}
+
 } // namespace
 
 MAIN(benchdata)
 {
     testPlan(0);
     benchAllocNTScalar();
+    benchClone(0u);
+    benchClone(4u);
+    benchAssign();
+    benchTable(false);
+    benchTable(true);
+    benchTypeBuild();
+    for(size_t n : {1u, 2u, 4u})
+        benchSharedEncode(n);
+    benchFieldLookup();
+    benchArrayOps();
 
     constexpr size_t nelem = 10000u;
     testDiag("test optimization for fixed size (POD) elements");
@@ -0,0 +1,93 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <vector>
+#include <memory>
+
+#include <pvxs/unittest.h>
+
+#include <utilpvt.h>
+#include <evhelper.h>
+
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+namespace {
+using namespace pvxs;
+
+struct Producer : public epicsThreadRunable
+{
+    const evbase& base;
+    epicsEvent& start;
+    const size_t count;
+    size_t& executed; // only accessed from loop worker
+    epicsThread worker;
+    Producer(const evbase& base, epicsEvent& start, size_t count, size_t& executed)
+        :base(base)
+        ,start(start)
+        ,count(count)
+        ,executed(executed)
+        ,worker(*this, "producer", epicsThreadGetStackSize(epicsThreadStackBig))
+    {
+        worker.start();
+    }
+
+    void run() override final {
+        start.wait();
+        start.signal(); // release next producer
+        for(size_t i=0; i<count; i++) {
+            auto& cnt = executed;
+            base.dispatch([&cnt]() {
+                cnt++;
+            });
+        }
+    }
+};
+
+void benchDispatch(size_t nproducers)
+{
+    testDiag("%s(%zu)", __func__, nproducers);
+
+    constexpr size_t total = 1000000u;
+    const size_t count = total/nproducers;
+
+    evbase base("BENCH");
+    epicsEvent start;
+    size_t executed = 0u;
+
+    epicsUInt64 T0, T1;
+    {
+        std::vector<std::unique_ptr<Producer>> producers;
+        for(size_t i=0; i<nproducers; i++)
+            producers.emplace_back(new Producer(base, start, count, executed));
+
+        T0 = epicsMonotonicGet();
+        start.signal();
+        // join producers
+    }
+    base.sync();
+    T1 = epicsMonotonicGet();
+
+    testEq(executed, count*nproducers);
+
+    double sec = (T1-T0)*1e-9;
+    testShow()<<" "<<nproducers<<" producers, "<<executed<<" dispatch() in "<<sec<<" sec. "
+              <<(executed/sec)<<" per sec.";
+}
+
+} // namespace
+
+MAIN(benchev)
+{
+    testPlan(0);
+    benchDispatch(1u);
+    benchDispatch(4u);
+    benchDispatch(16u);
+    return testDone();
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <vector>
+#include <atomic>
+
+#include <pvxs/unittest.h>
+
+#include <utilpvt.h>
+#include <evhelper.h>
+#include <pvaproto.h>
+#include <udp_collector.h>
+
+#include <osiSock.h>
+#include <epicsTime.h>
+#include <epicsThread.h>
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+namespace {
+using namespace pvxs;
+
+std::vector<uint8_t> searchPacket()
+{
+    std::vector<uint8_t> msg(1024, 0);
+    VectorOutBuf M(true, msg);
+
+    M.skip(8, __FILE__, __LINE__); // placeholder for header
+    to_wire(M, uint32_t(0x12345678));
+    M.skip(4, __FILE__, __LINE__);
+    SockAddr reply(SockAddr::any(AF_INET, 0x1020));
+    to_wire(M, reply);
+    to_wire(M, uint16_t(reply.port()));
+    to_wire(M, Size{1});
+    to_wire(M, "tcp");
+    to_wire(M, uint16_t(1u));
+    to_wire(M, uint32_t(1u));
+    to_wire(M, "bench:pv:name");
+
+    auto pktlen = M.save()-msg.data();
+
+    FixedBuf H(true, msg.data(), 8);
+    to_wire(H, Header{CMD_SEARCH, 0, uint32_t(pktlen-8)});
+
+    msg.resize(pktlen);
+    return msg;
+}
+
+/* Flood a UDPManager search listener through loopback.
+ * Reports how many Search messages are processed, and how quickly.
+ */
+void benchSearchRx(size_t burst)
+{
+    testDiag("%s(%zu)", __func__, burst);
+
+    constexpr size_t total = 200000u;
+
+    SockAddr listener(SockAddr::loopback(AF_INET));
+    SockAddr sender(SockAddr::loopback(AF_INET));
+
+    evsocket sock(AF_INET, SOCK_DGRAM, 0);
+    sock.bind(sender);
+
+    std::atomic<size_t> received{0u};
+    auto manager = UDPManager::instance();
+    auto sub = manager.onSearch(listener, [&received](const UDPManager::Search& msg)
+    {
+        received.fetch_add(1u, std::memory_order_relaxed);
+    });
+    sub->start();
+    manager.sync();
+
+    const auto msg(searchPacket());
+
+    UDPTxBatch tx;
+    size_t sent = 0u;
+
+    auto T0 = epicsMonotonicGet();
+    for(size_t n=0u; n<total; n+=burst) {
+        tx.clear();
+        for(size_t i=0u; i<burst; i++)
+            tx.push(msg.data(), msg.size(), listener);
+        tx.send(sock.sock);
+        for(size_t i=0u; i<tx.size(); i++)
+            sent += tx[i].ntx>0;
+    }
+    auto T1 = epicsMonotonicGet();
+
+    // wait for the receiver to drain
+    size_t prev;
+    do {
+        prev = received.load();
+        epicsThreadSleep(0.1);
+        manager.sync();
+    } while(prev!=received.load());
+    auto nrx = received.load();
+
+    double txsec = (T1-T0)*1e-9;
+    testShow()<<" burst "<<burst<<", sent "<<sent<<" in "<<txsec<<" sec. "<<(sent/txsec)<<" per sec.  "
+              <<"Received "<<nrx<<" ("<<(100.0*nrx/sent)<<" %)";
+}
+
+} // namespace
+
+MAIN(benchudp)
+{
+    SockAttach attach;
+    testPlan(0);
+    testDiag("recvmmsg()/sendmmsg() %s", UDPRxBatch::native() ? "used" : "not used");
+    benchSearchRx(1u);
+    benchSearchRx(16u);
+    benchSearchRx(64u);
+    return testDone();
+}
@@ -84,6 +84,50 @@ void testBasic3()
     testEq(std::string(SB()<<M), "{63, 64, 67}");
 }
 
+void testLarge()
+{
+    testDiag("%s", __func__);
+
+    // exceeds inline storage
+    BitMask M({0, 63, 64, 127, 128, 191, 300}, 301u);
+    testEq(M.size(), 301u);
+    testEq(M.wsize(), 5u);
+
+    testEq(M.findSet(1u), 63u);
+    testEq(M.findSet(129u), 191u);
+    testEq(M.findSet(192u), 300u);
+    testEq(M.findSet(301u), 301u);
+
+    testEq(std::string(SB()<<M), "{0, 63, 64, 127, 128, 191, 300}");
+
+    {
+        std::string partial;
+        for(auto bit : M.onlySet(63u, 191u))
+            partial += SB()<<bit<<' ';
+        testEq(partial, "63 64 127 128 ");
+    }
+
+    // move from heap
+    BitMask N(std::move(M));
+    testEq(M.size(), 0u);
+    testEq(std::string(SB()<<N), "{0, 63, 64, 127, 128, 191, 300}");
+
+    // move from inline
+    BitMask S({1, 2}, 100u);
+    N = std::move(S);
+    testEq(S.size(), 0u);
+    testEq(N.size(), 100u);
+    testEq(std::string(SB()<<N), "{1, 2}");
+
+    // grow from inline, and re-grow zeros
+    N.resize(3u);
+    N.resize(200u);
+    N[199] = true;
+    testEq(std::string(SB()<<N), "{1, 2, 199}");
+    testOk1(N==BitMask({1, 2, 199}, 200u));
+    testOk1(N!=BitMask({1, 2}, 200u));
+}
+
 void testOp()
 {
     testDiag("%s", __func__);
@@ -199,12 +243,13 @@ void testSer()
 
 MAIN(testbitmask)
 {
-    testPlan(76);
+    testPlan(92);
     testSetup();
     testEmpty();
     testBasic1();
     testBasic2();
     testBasic3();
+    testLarge();
     testOp();
     testExpr();
     testSer();
@@ -47,6 +47,119 @@ void testTraverse()
     testFalse(top.equalType(top["value"]));
 }
 
+void testFieldRef()
+{
+    testDiag("%s", __func__);
+
+    auto top = nt::NTScalar{TypeCode::Int32, true}.create();
+    auto other = top.cloneEmpty();
+    auto different = nt::NTScalar{TypeCode::Int32, true, true}.create(); // also has alarm.severity
+
+    FieldRef value(top, "value");
+    FieldRef sevr(top, "alarm.severity");
+    FieldRef self(top, "");
+    FieldRef parent(top, "value<alarm"); // not resolved
+    FieldRef nosuch(top, "nonexistent");
+
+    testOk1(value.resolved());
+    testOk1(sevr.resolved());
+    testOk1(self.resolved());
+    testOk1(!parent.resolved());
+    testOk1(!nosuch.resolved());
+    testOk1(!FieldRef("value").resolved());
+
+    testOk1(top[value].equalInst(top["value"]));
+    testOk1(top[sevr].equalInst(top["alarm.severity"]));
+    testOk1(top[self].equalInst(top));
+    testOk1(top[parent].equalInst(top["alarm"]));
+    testOk1(!top[nosuch].valid());
+    testOk1(!Value()[value].valid());
+
+    // same type, different instance
+    testOk1(other[sevr].equalInst(other["alarm.severity"]));
+    testFalse(other[sevr].equalInst(top[sevr]));
+
+    // different type, fall back to parsing
+    testOk1(different[sevr].equalInst(different["alarm.severity"]));
+    testOk1(!different["value"][sevr].valid());
+
+    {
+        const Value& ctop = top;
+        testOk1(ctop[sevr].equalInst(top["alarm.severity"]));
+        testOk1(ctop.lookup(sevr).equalInst(top["alarm.severity"]));
+    }
+
+    top[sevr] = 3;
+    testEq(top["alarm.severity"].as<int32_t>(), 3);
+    testOk1(top[sevr].isMarked());
+
+    testThrows<LookupError>([&top, &nosuch](){
+        top.lookup(nosuch);
+    });
+    testThrows<LookupError>([&different, &nosuch](){
+        different.lookup(nosuch);
+    });
+}
+
+void testValuePool()
+{
+    testDiag("%s", __func__);
+
+    auto count = [](const char* name) -> size_t {
+        return instanceSnapshot()[name];
+    };
+
+    setValuePoolLimit(2u);
+    {
+        auto proto = nt::NTScalar{TypeCode::Int32, true}.create();
+        testEq(count("StructPool"), 1u);
+        testEq(valuePoolStats().miss, 1u);
+        testEq(count("StructPoolFree"), 0u);
+
+        {
+            auto A = proto.cloneEmpty();
+            auto B = proto.cloneEmpty();
+            auto C = proto.cloneEmpty();
+            testEq(valuePoolStats().miss, 4u);
+            B["value"] = 42;
+        }
+        // limited to two
+        testEq(count("StructPoolFree"), 2u);
+
+        {
+            auto A = proto.cloneEmpty();
+            auto B = proto.clone();
+            testEq(valuePoolStats().hit, 2u);
+            testEq(count("StructPoolFree"), 0u);
+            // recycled storage is re-initialized
+            testEq(A["value"].as<int32_t>(), 0);
+            testFalse(A["value"].isMarked());
+            testEq(A["alarm.message"].as<std::string>(), "");
+        }
+        testEq(count("StructPoolFree"), 2u);
+
+        // sub-structure has a separate pool
+        {
+            auto alarm = proto["alarm"].cloneEmpty();
+            testEq(count("StructPool"), 2u);
+            testEq(valuePoolStats().miss, 5u);
+        }
+    }
+    // pools released along with type
+    testEq(count("StructPool"), 0u);
+    testEq(count("StructPoolFree"), 0u);
+
+    setValuePoolLimit(0u);
+    testEq(valuePoolStats().hit, 0u);
+    testEq(valuePoolStats().miss, 0u);
+
+    {
+        auto proto = nt::NTScalar{TypeCode::Int32, true}.create();
+        auto A = proto.cloneEmpty();
+        testEq(count("StructPool"), 0u);
+    }
+}
+
 void testAssign()
 {
     testDiag("%s", __func__);
@@ -70,6 +183,233 @@ void testAssign()
     testEq(val["alarm.severity"].as<epicsAlarmSeverity>(), INVALID_ALARM);
 }
 
+// assign() between Values of the same type (copy by index)
+// matches assign() between similar types (copy by name)
+void testAssignSame()
+{
+    testDiag("%s", __func__);
+
+    auto fields = {
+        members::Int32("i"),
+        members::Float32("f"),
+        members::Bool("b"),
+        members::String("s"),
+        members::Float64A("arr"),
+        members::StructA("sa", {
+            members::Int32("x"),
+        }),
+        members::Union("u", {
+            members::String("s"),
+            members::Int32("i"),
+            members::Struct("st", {
+                members::Int32("y"),
+            }),
+        }),
+        members::Any("any"),
+        members::Struct("sub", {
+            members::UInt16("a"),
+            members::String("b"),
+        }),
+    };
+    TypeDef same(TypeCode::Struct, "test:same", fields);
+    TypeDef other(TypeCode::Struct, "test:other", fields);
+
+    auto src = same.create();
+    src["i"] = -5;
+    src["f"] = 1.5;
+    src["b"] = true;
+    src["s"] = "hello";
+    src["arr"] = shared_array<const double>({1.0, 2.0});
+    src["any"] = "something";
+    src["sub.a"] = 3;
+
+    auto fast = same.create();
+    auto slow = other.create();
+    fast.assign(src);
+    slow.assign(src);
+
+    auto show = [](const Value& top) -> std::string {
+        std::ostringstream strm;
+        for(auto fld : top.iall()) {
+            strm<<top.nameOf(fld)<<" "<<fld.isMarked(false, false)<<" "<<fld.format()<<"\n";
+        }
+        return strm.str();
+    };
+
+    testEq(show(fast), show(slow));
+
+    // Struct[] and Union only possible with the same type
+    {
+        shared_array<Value> arr(1u);
+        arr[0] = src["sa"].allocMember();
+        arr[0]["x"] = 4;
+        src["sa"] = arr.freeze().castTo<const void>();
+    }
+    src["u->i"] = 7;
+    fast.assign(src);
+    testEq(fast["sa"].as<shared_array<const void>>().size(), 1u);
+
+    src["u->i"] = 8;
+    testEq(fast["u"].as<int32_t>(), 7)<<" Union selection is copied, not shared";
+
+    // marking propagates to an enclosing Union
+    auto inner = fast["u->st"];
+    fast.unmark(false, true);
+    auto sinner = src["u->st"];
+    sinner["y"] = 5;
+    inner.assign(sinner);
+    testTrue(fast["u"].isMarked(false, false));
+}
+
+void testColumns()
+{
+    testDiag("%s", __func__);
+
+    auto def = TypeDef(TypeCode::Struct, {
+                           members::StructA("table", "row_t", {
+                               members::Float64("x"),
+                               members::String("name"),
+                               members::Struct("pos", {
+                                   members::Int32("a"),
+                                   members::UInt8("b"),
+                               }),
+                               members::Bool("flag"),
+                           }),
+                       });
+
+    auto val = def.create();
+
+    auto cols = val["table"].columns();
+    testEq(cols["x"].as<shared_array<const void>>().size(), 0u);
+
+    cols["x"] = shared_array<const double>({1.5, 2.5, 3.5});
+    cols["name"] = shared_array<const std::string>({"one", "two", "three"});
+    cols["pos.a"] = shared_array<const int32_t>({-1, -2, -3});
+    cols["pos.b"] = shared_array<const uint8_t>({200u, 201u, 202u});
+
+    testThrows<NoConvert>([&val, &cols]() {
+        val["table"].assign(cols); // "flag" is empty
+    });
+
+    cols["flag"] = shared_array<const bool>({true, false, true});
+    val["table"].assign(cols);
+    testTrue(val["table"].isMarked());
+    testEq(Value::Helper::store_ptr(val["table"])->code, StoreType::Compound);
+    testEq(val["table"].storageType(), StoreType::Array);
+
+    // elements created on demand
+    auto rows = val["table"].as<shared_array<const Value>>();
+    testEq(rows.size(), 3u);
+    testEq(rows[1]["name"].as<std::string>(), "two");
+    testEq(rows[2]["pos.b"].as<uint32_t>(), 202u);
+    {
+        // indexing a const Value does not change storage
+        const Value& cval = val;
+        testEq(cval["table[0].pos.a"].as<int32_t>(), -1);
+        testEq(Value::Helper::store_ptr(val["table"])->code, StoreType::Compound);
+    }
+
+    // same encoding as element-wise
+    auto rowval = def.create();
+    rowval["table"] = rows;
+    testEq(Value::Helper::store_ptr(rowval["table"])->code, StoreType::Array);
+    testEq(std::string(SB()<<val), std::string(SB()<<rowval));
+
+    std::vector<uint8_t> colbytes, rowbytes;
+    {
+        VectorOutBuf buf(true, colbytes);
+        to_wire_full(buf, val);
+        colbytes.resize(colbytes.size()-buf.size());
+    }
+    {
+        VectorOutBuf buf(true, rowbytes);
+        to_wire_full(buf, rowval);
+        rowbytes.resize(rowbytes.size()-buf.size());
+    }
+    testTrue(colbytes==rowbytes)<<" encoded "<<colbytes.size()<<" and "<<rowbytes.size()<<" bytes";
+
+    // received data is decoded element-wise by default
+    {
+        auto dval = def.create();
+        TypeStore ctxt;
+        FixedBuf buf(true, rowbytes);
+        from_wire_full(buf, ctxt, dval);
+        testTrue(buf.good() && buf.empty());
+        testEq(Value::Helper::store_ptr(dval["table"])->code, StoreType::Array);
+        testEq(std::string(SB()<<dval), std::string(SB()<<rowval));
+    }
+
+    // decoded column-wise into a field already stored column-wise
+    {
+        auto dval = def.create();
+        dval["table"].assign(dval["table"].columns());
+        TypeStore ctxt;
+        FixedBuf buf(true, rowbytes);
+        from_wire_full(buf, ctxt, dval);
+        testTrue(buf.good() && buf.empty());
+        testEq(Value::Helper::store_ptr(dval["table"])->code, StoreType::Compound);
+        auto dcols = dval["table"].columns();
+        testArrEq(dcols["pos.b"].as<shared_array<const uint8_t>>(), shared_array<const uint8_t>({200u, 201u, 202u}));
+        testArrEq(dcols["name"].as<shared_array<const std::string>>(), shared_array<const std::string>({"one", "two", "three"}));
+
+        const Value& cdval = dval;
+        testEq(cdval["table[1].name"].as<std::string>(), "two");
+
+        // writing through an element switches to element-wise storage
+        dval["table[1].pos.a"] = 5;
+        testEq(Value::Helper::store_ptr(dval["table"])->code, StoreType::Array);
+        testEq(dval["table[1].pos.a"].as<int32_t>(), 5);
+        testEq(dval["table[0].pos.a"].as<int32_t>(), -1);
+        testEq(dval["table[2].name"].as<std::string>(), "three");
+    }
+
+    // element-wise to column-wise
+    {
+        auto rcols = rowval["table"].columns();
+        testArrEq(rcols["x"].as<shared_array<const double>>(), shared_array<const double>({1.5, 2.5, 3.5}));
+    }
+
+    // a null element is decoded element-wise
+    {
+        shared_array<Value> nrows(rows.size());
+        nrows[0] = rows[0];
+        nrows[2] = rows[2];
+        rowval["table"] = nrows.freeze();
+
+        rowbytes.clear();
+        {
+            VectorOutBuf buf(true, rowbytes);
+            to_wire_full(buf, rowval);
+            rowbytes.resize(rowbytes.size()-buf.size());
+        }
+        auto dval = def.create();
+        dval["table"].assign(dval["table"].columns());
+        TypeStore ctxt;
+        FixedBuf buf(true, rowbytes);
+        from_wire_full(buf, ctxt, dval);
+        testTrue(buf.good() && buf.empty());
+        testEq(Value::Helper::store_ptr(dval["table"])->code, StoreType::Array);
+        testEq(std::string(SB()<<dval), std::string(SB()<<rowval));
+
+        testThrows<NoConvert>([&dval]() {
+            dval["table"].columns();
+        });
+    }
+
+    // copies of column-wise Struct[]
+    {
+        auto copy = val.clone();
+        testEq(Value::Helper::store_ptr(copy["table"])->code, StoreType::Compound);
+        testEq(std::string(SB()<<copy), std::string(SB()<<val));
+    }
+
+    testThrows<NoConvert>([]() {
+        TypeDef(TypeCode::StructA, {
+                    members::Union("u", {}),
+                }).create().columns();
+    });
+}
+
 void testAssignUnion()
 {
     testDiag("%s", __func__);
@@ -346,10 +686,14 @@ void testExtract()
 
 MAIN(testdata)
 {
-    testPlan(116);
+    testPlan(193);
     testSetup();
     testTraverse();
+    testFieldRef();
+    testValuePool();
     testAssign();
+    testAssignSame();
+    testColumns();
     testAssignUnion();
     testName();
     testIterStruct();
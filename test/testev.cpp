@@ -4,9 +4,16 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <vector>
+#include <array>
+
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
+#include <epicsThread.h>
+
+#include <event2/bufferevent.h>
+#include <event2/buffer.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -98,6 +105,101 @@ void test_call()
     testFalse(internal.tryCall([](){}));
 }
 
+void test_mfunction()
+{
+    testDiag("%s", __func__);
+    using impl::mfunction;
+
+    auto A(std::make_shared<int>(1));
+    auto B(std::make_shared<int>(2));
+    int sum = 0;
+    auto nheap = impl::mfunctionHeapCount();
+    {
+        mfunction small([&sum, A, B]() {
+            sum += *A + *B;
+        });
+        testEq(instanceSnapshot()["mfunctionAlloc"], 0u)<<" small functor stored inline";
+        testEq(impl::mfunctionHeapCount(), nheap);
+        testEq(A.use_count(), 2);
+
+        mfunction moved(std::move(small));
+        testFalse(small)<<" moved from";
+        testEq(A.use_count(), 2)<<" moved, not copied";
+        moved();
+        testEq(sum, 3);
+    }
+    testEq(A.use_count(), 1);
+
+    {
+        std::array<size_t, 64> big{};
+        big[1] = 4;
+        mfunction large([&sum, big]() {
+            sum += int(big[1]);
+        });
+        testEq(instanceSnapshot()["mfunctionAlloc"], 1u)<<" large functor allocated";
+        testEq(impl::mfunctionHeapCount(), nheap+1u);
+
+        mfunction moved;
+        moved = std::move(large);
+        testEq(instanceSnapshot()["mfunctionAlloc"], 1u);
+        moved();
+        testEq(sum, 7);
+    }
+    testEq(instanceSnapshot()["mfunctionAlloc"], 0u);
+    testEq(impl::mfunctionHeapCount(), nheap+1u)<<" cumulative";
+}
+
+struct Dispatcher : public epicsThreadRunable
+{
+    const evbase& base;
+    std::vector<size_t>& rxd;
+    const size_t count;
+    epicsThread worker;
+    Dispatcher(const evbase& base, std::vector<size_t>& rxd, size_t count)
+        :base(base)
+        ,rxd(rxd)
+        ,count(count)
+        ,worker(*this, "dispatcher", epicsThreadGetStackSize(epicsThreadStackBig))
+    {
+        worker.start();
+    }
+
+    void run() override final {
+        for(size_t i=0; i<count; i++) {
+            // each producer's actions must be executed in order
+            base.dispatch([this, i]() {
+                if(rxd.size()!=i)
+                    testFail("Out of order %zu != %zu", rxd.size(), i);
+                rxd.push_back(i);
+            });
+        }
+    }
+};
+
+void test_dispatch_many()
+{
+    testDiag("%s", __func__);
+
+    evbase base("TEST");
+
+    // more than one batch from each producer
+    constexpr size_t count = 5000u;
+    std::vector<size_t> A, B, C, D;
+    {
+        Dispatcher a(base, A, count);
+        Dispatcher b(base, B, count);
+        Dispatcher c(base, C, count);
+        Dispatcher d(base, D, count);
+        // join
+    }
+    base.sync();
+
+    testEq(A.size(), count);
+    testEq(B.size(), count);
+    testEq(C.size(), count);
+    testEq(D.size(), count);
+}
+
 void test_fill_evbuf()
 {
     testDiag("%s", __func__);
@@ -142,15 +244,126 @@ void test_fill_evbuf()
     testEq(evbuffer_get_length(buf.get()), 0u);
 }
 
+void test_bounded_priority()
+{
+    testDiag("%s", __func__);
+
+#if LIBEVENT_VERSION_NUMBER >= 0x02010000
+    evbase base("TEST");
+
+    evutil_socket_t hi[2], lo[2];
+#ifdef _WIN32
+    const int family = AF_INET;
+#else
+    const int family = AF_UNIX;
+#endif
+    if(evutil_socketpair(family, SOCK_STREAM, 0, hi) || evutil_socketpair(family, SOCK_STREAM, 0, lo))
+        testAbort("Unable to create socket pairs");
+
+    // congest the high priority connection by filling its socket buffer
+    size_t total = 0u;
+    {
+        evutil_make_socket_nonblocking(hi[1]);
+        std::vector<char> junk(4096u, 'x');
+        for(int n; (n=send(hi[1], junk.data(), junk.size(), 0))>0; )
+            total += size_t(n);
+        testOk(total>0u, "Queued %zu bytes", total);
+        testOk1(send(lo[1], "y", 1, 0)==1);
+    }
+
+    struct Rx {
+        evbufferevent bev;
+        BoundedPriority prio{bev};
+        size_t nread = 0u; // bytes
+        size_t ncb = 0u;   // callbacks
+        size_t hiAtLo = 0u; // hi->ncb when lo was first serviced
+        size_t hiBytesAtLo = 0u;
+        Rx* other = nullptr;
+        mfunction onFirst;
+        static void readS(bufferevent *bev, void *raw) {
+            auto self = static_cast<Rx*>(raw);
+            self->prio.tick();
+            auto buf = bufferevent_get_input(bev);
+            auto n = evbuffer_get_length(buf);
+            evbuffer_drain(buf, n);
+            if(self->other && !self->ncb) {
+                self->hiAtLo = self->other->ncb;
+                self->hiBytesAtLo = self->other->nread;
+            }
+            if(self->onFirst && !self->ncb)
+                self->onFirst();
+            self->nread += n;
+            self->ncb++;
+        }
+    } rxHi, rxLo;
+    rxLo.other = &rxHi;
+    size_t hiBytesAtWork = 0u;
+    bool workDone = false;
+    // queue to the work queue event, at the default level, while congested
+    rxHi.onFirst = [&]() {
+        base.dispatch([&]() {
+            hiBytesAtWork = rxHi.nread;
+            workDone = true;
+        });
+    };
+
+    base.call([&]() {
+        rxHi.bev.reset(bufferevent_socket_new(base.base, hi[0], BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS));
+        rxLo.bev.reset(bufferevent_socket_new(base.base, lo[0], BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS));
+        // many small reads to keep the high priority connection busy
+        bufferevent_set_max_single_read(rxHi.bev.get(), 256);
+        testOk1(rxHi.prio.set(0));
+        testOk1(rxLo.prio.set(evbase_default_priority));
+        for(auto rx : {&rxHi, &rxLo}) {
+            bufferevent_setcb(rx->bev.get(), &Rx::readS, nullptr, nullptr, rx);
+            bufferevent_enable(rx->bev.get(), EV_READ);
+        }
+    });
+
+    // wait for the high priority connection to drain
+    for(size_t i=0; i<100u; i++) {
+        bool done = false;
+        base.call([&]() { done = rxHi.nread==total && rxLo.nread==1u; });
+        if(done)
+            break;
+        epicsThreadSleep(0.1);
+    }
+
+    base.call([&]() {
+        testEq(rxHi.nread, total);
+        testEq(rxLo.nread, 1u);
+        testOk(rxHi.ncb > BoundedPriority::burst_limit, "hi callbacks %zu", rxHi.ncb);
+        // served first, but did not starve the default level
+        testOk(rxLo.hiAtLo>0u && rxLo.hiAtLo<=BoundedPriority::burst_limit,
+               "lo serviced after %zu hi callbacks", rxLo.hiAtLo);
+        testOk(rxLo.hiBytesAtLo < total, "lo serviced after %zu of %zu bytes", rxLo.hiBytesAtLo, total);
+        testOk(workDone && hiBytesAtWork>0u && hiBytesAtWork < total, "work serviced after %zu of %zu bytes", hiBytesAtWork, total);
+        testOk(rxHi.prio.ndemote>0u, "demoted %zu times", rxHi.prio.ndemote);
+        testEq(rxLo.prio.ndemote, 0u);
+
+        rxHi.bev.reset();
+        rxLo.bev.reset();
+    });
+
+    evutil_closesocket(hi[1]);
+    evutil_closesocket(lo[1]);
+#else
+    testSkip(12, "BoundedPriority test requires libevent >= 2.1");
+#endif
+}
+
 } // namespace
 
 MAIN(testev)
 {
     SockAttach attach;
-    testPlan(20);
+    testPlan(49);
     testSetup();
     test_call();
+    test_mfunction();
+    test_dispatch_many();
     test_fill_evbuf();
+    test_bounded_priority();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -6,6 +6,7 @@
 #define PVXS_ENABLE_EXPERT_API
 
 #include <atomic>
+#include <set>
 
 #include <testMain.h>
 
@@ -494,11 +495,75 @@ void testError(bool phase)
     }
 }
 
+void testSegmented()
+{
+    testShow()<<__func__;
+
+    shared_array<double> arr(10000u);
+    for(size_t i=0u; i<arr.size(); i++)
+        arr[i] = i;
+    auto expect(arr.freeze());
+
+    auto initial(nt::NTScalar{TypeCode::Float64A}.create());
+    initial["value"] = expect;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto conf(server::Config::isolated());
+    conf.segmentSize = 1000u;
+    auto serv(conf.build()
+              .addPV("mailbox", mbox)
+              .start());
+    testEq(serv.config().segmentSize, 1000u);
+
+    auto cli(serv.clientConfig().build());
+
+    // reply body of ~80KB is sent as ~80 segments
+    auto val(cli.get("mailbox").exec()->wait(5.0));
+    testArrEq(val["value"].as<shared_array<const double>>(), expect);
+
+    // still connected, and small replies are sent unsegmented
+    val = cli.get("mailbox").field("alarm").exec()->wait(5.0);
+    testTrue(val["alarm"].valid());
+}
+
+void testPriority()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv(server::Config::isolated()
+              .build()
+              .addPV("mailbox", mbox)
+              .start());
+    auto cli(serv.clientConfig().build());
+
+    // one connection for each distinct priority.  out of range is clamped
+    for(int prio : {0, 50, 50, 200}) {
+        auto val(cli.get("mailbox").priority(prio).exec()->wait(5.0));
+        testEq(val["value"].as<int32_t>(), 42)<<" priority "<<prio;
+    }
+
+    std::set<unsigned> sprios, cprios;
+    for(auto& conn : serv.report().connections)
+        sprios.insert(conn.priority);
+    for(auto& conn : cli.report().connections)
+        cprios.insert(conn.priority);
+
+    std::set<unsigned> expect({0u, 50u, 99u});
+    testTrue(sprios==expect)<<" server sees "<<sprios.size()<<" priorities";
+    testTrue(cprios==expect)<<" client has "<<cprios.size()<<" priorities";
+}
+
 } // namespace
 
 MAIN(testget)
 {
-    testPlan(57);
+    testPlan(66);
     testSetup();
     logger_config_env();
     Tester().testConnector();
@@ -515,6 +580,8 @@ MAIN(testget)
     Tester().ordering();
     testError(false);
     testError(true);
+    testSegmented();
+    testPriority();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -241,11 +241,82 @@ void testError()
     }
 }
 
+struct ScalarSource : public server::Source
+{
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+
+        chan->onOp([](std::unique_ptr<server::ConnectOp>&& op) {
+            // each channel builds its own, identical, type
+            op->connect(nt::NTScalar{TypeCode::Float64, true, true}.create());
+        });
+    }
+};
+
+// total bytes sent by a server replying to GET_FIELD for nchan channels
+size_t infoTxBytes(bool typeCache, size_t nchan)
+{
+    auto conf(server::Config::isolated());
+    conf.typeCache = typeCache;
+    auto serv = conf.build()
+            .addSource("scalar", std::make_shared<ScalarSource>())
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    for(size_t i=0u; i<nchan; i++) {
+        client::Result actual;
+        epicsEvent done;
+
+        auto op = cli.info("pv"+std::to_string(i))
+                .result([&actual, &done](client::Result&& result) {
+                    actual = std::move(result);
+                    done.signal();
+                })
+                .exec();
+
+        cli.hurryUp();
+
+        if(!done.wait(5.0)) {
+            testFail("timeout");
+            break;
+        }
+        auto val(actual());
+        if(val["value"].type().kind()!=Kind::Real)
+            testFail("unexpected type for #%u", unsigned(i));
+    }
+
+    size_t tx = 0u;
+    auto report(serv.report());
+    for(auto& conn : report.connections)
+        tx += conn.tx;
+    return tx;
+}
+
+void testTypeCache()
+{
+    testShow()<<__func__;
+
+    auto full = infoTxBytes(false, 10u);
+    auto cached = infoTxBytes(true, 10u);
+    testShow()<<"Server sent "<<full<<" bytes without, and "<<cached<<" bytes with, type cache";
+
+    // 9 of 10 type descriptions sent as 3 byte references
+    testOk(full > cached + 9u*60u, "cache saves %u bytes", unsigned(full-cached));
+}
+
 } // namespace
 
 MAIN(testinfo)
 {
-    testPlan(13);
+    testPlan(14);
     testSetup();
     logger_config_env();
     Tester().loopback();
@@ -255,5 +326,6 @@ MAIN(testinfo)
     Tester().asyncCancel();
     Tester().orphan();
     testError();
+    testTypeCache();
     return testDone();
 }
@@ -12,6 +12,9 @@
 #include <epicsUnitTest.h>
 
 #include <epicsEvent.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+#include <epicsThread.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -328,11 +331,353 @@ struct TestReconn : public BasicTest
     }
 };
 
+void testWorkers(bool reuseport)
+{
+    testShow()<<__func__<<" "<<reuseport;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto conf(server::Config::isolated());
+    conf.tcpWorkers = 3u;
+    conf.tcpReusePort = reuseport;
+    auto serv(conf.build()
+              .addPV("mailbox", mbox)
+              .start());
+
+    testEq(serv.config().tcpWorkers, 3u);
+
+    // more clients than workers, so some workers have more than one connection
+    constexpr size_t nclients = 4u;
+    std::vector<client::Context> clis;
+    std::vector<std::shared_ptr<client::Subscription>> subs;
+    std::vector<std::unique_ptr<epicsEvent>> evts;
+
+    for(size_t i=0u; i<nclients; i++) {
+        clis.push_back(serv.clientConfig().build());
+        evts.emplace_back(new epicsEvent());
+        auto evt = evts.back().get();
+        subs.push_back(clis.back().monitor("mailbox")
+                       .maskConnected(true)
+                       .maskDisconnected(true)
+                       .event([evt](client::Subscription&) {
+                           evt->signal();
+                       })
+                       .exec());
+    }
+
+    for(size_t i=0u; i<nclients; i++) {
+        auto val(BasicTest::pop(subs[i], *evts[i]));
+        testEq(val["value"].as<int32_t>(), 42)<<" client "<<i;
+    }
+
+    auto update(initial.cloneEmpty());
+    update["value"] = 43;
+    mbox.post(update);
+
+    for(size_t i=0u; i<nclients; i++) {
+        auto val(BasicTest::pop(subs[i], *evts[i]));
+        testEq(val["value"].as<int32_t>(), 43)<<" client "<<i;
+    }
+
+    auto report(serv.report());
+    testEq(report.connections.size(), nclients);
+    for(auto& conn : report.connections)
+        testEq(conn.backlog, 0u)<<" "<<conn.peer;
+}
+
+void testFanout()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv(server::Config::isolated().build()
+              .addPV("mailbox", mbox)
+              .start());
+    auto cli(serv.clientConfig().build());
+
+    // subscribers with the same pvRequest share an encoded update
+    constexpr size_t nsubs = 4u;
+    std::vector<std::shared_ptr<client::Subscription>> subs;
+    std::vector<std::unique_ptr<epicsEvent>> evts;
+
+    for(size_t i=0u; i<nsubs; i++) {
+        evts.emplace_back(new epicsEvent());
+        auto evt = evts.back().get();
+        auto builder(cli.monitor("mailbox"));
+        if(i&1)
+            builder.field("value");
+        subs.push_back(builder.maskConnected(true)
+                       .maskDisconnected(true)
+                       .event([evt](client::Subscription&) {
+                           evt->signal();
+                       })
+                       .exec());
+    }
+
+    for(size_t i=0u; i<nsubs; i++) {
+        auto val(BasicTest::pop(subs[i], *evts[i]));
+        testEq(val["value"].as<int32_t>(), 42)<<" sub "<<i;
+    }
+
+    auto update(initial.cloneEmpty());
+    update["value"] = 43;
+    update["alarm.severity"] = 2;
+    mbox.post(update);
+
+    for(size_t i=0u; i<nsubs; i++) {
+        auto val(BasicTest::pop(subs[i], *evts[i]));
+        testEq(val["value"].as<int32_t>(), 43)<<" sub "<<i;
+        if(i&1)
+            testFalse(val["alarm.severity"].isMarked())<<" sub "<<i;
+        else
+            testEq(val["alarm.severity"].as<int32_t>(), 2)<<" sub "<<i;
+    }
+
+    // a shared encoding large enough to be sent by reference
+    shared_array<int32_t> wave(4096u);
+    for(size_t i=0u; i<wave.size(); i++)
+        wave[i] = int32_t(i);
+    auto waveform(nt::NTScalar{TypeCode::Int32A}.create());
+    waveform["value"] = wave.freeze();
+    auto wbox(server::SharedPV::buildReadonly());
+    wbox.open(waveform);
+    serv.addPV("waveform", wbox);
+
+    std::vector<std::shared_ptr<client::Subscription>> wsubs;
+    for(size_t i=0u; i<nsubs; i++) {
+        auto evt = evts[i].get();
+        wsubs.push_back(cli.monitor("waveform")
+                        .maskConnected(true)
+                        .maskDisconnected(true)
+                        .event([evt](client::Subscription&) {
+                            evt->signal();
+                        })
+                        .exec());
+    }
+    for(size_t i=0u; i<nsubs; i++) {
+        (void)BasicTest::pop(wsubs[i], *evts[i]);
+    }
+
+    shared_array<int32_t> wave2(wave.size());
+    for(size_t i=0u; i<wave2.size(); i++)
+        wave2[i] = -int32_t(i);
+    auto expect(wave2.freeze());
+    auto wupdate(waveform.cloneEmpty());
+    wupdate["value"] = expect;
+    wbox.post(wupdate);
+
+    for(size_t i=0u; i<nsubs; i++) {
+        auto val(BasicTest::pop(wsubs[i], *evts[i]));
+        testArrEq(val["value"].as<shared_array<const int32_t>>(), expect)<<" sub "<<i;
+    }
+}
+
+void testManyOps()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv(server::Config::isolated().build()
+              .addPV("mailbox", mbox)
+              .start());
+    auto cli(serv.clientConfig().build());
+
+    // many subscriptions through one connection, whose replies are sent together
+    constexpr size_t nsubs = 100u;
+    std::vector<std::shared_ptr<client::Subscription>> subs;
+    epicsEvent evt;
+
+    for(size_t i=0u; i<nsubs; i++) {
+        subs.push_back(cli.monitor("mailbox")
+                       .maskConnected(true)
+                       .maskDisconnected(true)
+                       .event([&evt](client::Subscription&) {
+                           evt.signal();
+                       })
+                       .exec());
+    }
+
+    for(int32_t v=43; v<46; v++) {
+        auto update(initial.cloneEmpty());
+        update["value"] = v;
+        mbox.post(update);
+    }
+
+    // wait for final update
+    size_t nlast = 0u, ndone = 0u;
+    std::vector<bool> done(nsubs, false);
+    while(ndone < nsubs) {
+        for(size_t i=0u; i<nsubs; i++) {
+            while(auto val = subs[i]->pop()) {
+                if(val["value"].as<int32_t>()==45 && !done[i]) {
+                    done[i] = true;
+                    ndone++;
+                }
+            }
+        }
+        if(ndone < nsubs && !evt.wait(5.0)) {
+            if(nlast==ndone)
+                break; // no progress
+            nlast = ndone;
+        }
+    }
+    testEq(ndone, nsubs);
+}
+
+void testBacklog()
+{
+    testShow()<<__func__;
+
+    // large enough to fill socket buffers and the server TX buffer quickly
+    constexpr size_t nelem = 0x20000u; // 1MB of double
+    auto initial(nt::NTScalar{TypeCode::Float64A}.create());
+    auto mkval = [&initial](double seq) {
+        auto ret(initial.cloneEmpty());
+        ret["value"] = shared_array<const double>(nelem, seq);
+        return ret;
+    };
+
+    // one hot PV, and two cold
+    constexpr size_t npvs = 3u;
+    std::vector<server::SharedPV> pvs;
+    auto builder(server::Config::isolated().build());
+    for(size_t i=0u; i<npvs; i++) {
+        pvs.push_back(server::SharedPV::buildReadonly());
+        pvs.back().open(mkval(0.0));
+        builder.addPV("pv"+std::to_string(i), pvs.back());
+    }
+    auto serv(builder.start());
+    auto cli(serv.clientConfig().build());
+
+    // record updates in the order received, from the client worker.
+    // Block the worker while paused, so that the client stops reading.
+    epicsMutex lock;
+    std::vector<std::pair<size_t, double>> rxd;
+    bool pause = false;
+    epicsEvent paused, resume, evt;
+
+    std::vector<std::shared_ptr<client::Subscription>> subs;
+    for(size_t i=0u; i<npvs; i++) {
+        subs.push_back(cli.monitor("pv"+std::to_string(i))
+                       .record("queueSize", 8)
+                       .maskConnected(true)
+                       .maskDisconnected(true)
+                       .event([&, i](client::Subscription& sub) {
+                           bool block;
+                           {
+                               epicsGuard<epicsMutex> G(lock);
+                               while(auto val = sub.pop())
+                                   rxd.emplace_back(i, val["value"].as<shared_array<const double>>()[0]);
+                               block = pause;
+                               pause = false;
+                           }
+                           evt.signal();
+                           if(block) {
+                               paused.signal();
+                               resume.wait();
+                           }
+                       })
+                       .exec());
+    }
+
+    auto nrxd = [&]() -> size_t {
+        epicsGuard<epicsMutex> G(lock);
+        return rxd.size();
+    };
+    while(nrxd() < npvs) {
+        if(!evt.wait(5.0)) {
+            testFail("timeout waiting for initial updates");
+            break;
+        }
+    }
+    auto backlog = [&serv]() -> size_t {
+        auto report(serv.report());
+        return report.connections.size()==1u ? report.connections.front().backlog : 0u;
+    };
+    testEq(backlog(), 0u);
+
+    {
+        epicsGuard<epicsMutex> G(lock);
+        rxd.clear();
+        pause = true;
+    }
+    pvs[0].post(mkval(1.0));
+    testOk1(paused.wait(5.0));
+
+    // post to the hot PV until its updates are delayed
+    double seq = 2.0;
+    for(; seq<100.0 && !backlog(); seq+=1.0) {
+        pvs[0].post(mkval(seq));
+        epicsThreadSleep(0.01);
+    }
+    testOk(backlog()>0u, "congested after %g updates", seq-1.0);
+
+    // hot PV has several updates waiting, then one for each cold PV
+    for(unsigned n=0u; n<8u; n++, seq+=1.0)
+        pvs[0].post(mkval(seq));
+    const double lastHot = seq-1.0;
+    pvs[1].post(mkval(1000.0));
+    pvs[2].post(mkval(2000.0));
+
+    // each operation queued once, regardless of the number of updates waiting
+    size_t nbacklog = 0u;
+    for(unsigned n=0u; n<100u && (nbacklog = backlog())<npvs; n++)
+        epicsThreadSleep(0.01);
+    testEq(nbacklog, npvs);
+
+    resume.signal();
+
+    // wait for the final update of each PV
+    auto complete = [&]() -> bool {
+        epicsGuard<epicsMutex> G(lock);
+        bool hot = false, cold1 = false, cold2 = false;
+        for(auto& upd : rxd) {
+            hot |= upd.first==0u && upd.second==lastHot;
+            cold1 |= upd.first==1u && upd.second==1000.0;
+            cold2 |= upd.first==2u && upd.second==2000.0;
+        }
+        return hot && cold1 && cold2;
+    };
+    while(!complete()) {
+        if(!evt.wait(5.0)) {
+            testFail("timeout waiting for final updates");
+            break;
+        }
+    }
+    testEq(backlog(), 0u);
+
+    // cold PVs are served in rotation with the hot PV, not after all of its updates.
+    size_t hotAfterCold = 0u;
+    {
+        epicsGuard<epicsMutex> G(lock);
+        size_t ncold = 0u;
+        for(auto& upd : rxd) {
+            if(upd.first!=0u)
+                ncold++;
+            else if(ncold==npvs-1u)
+                hotAfterCold++;
+        }
+        testEq(ncold, npvs-1u);
+    }
+    testOk(hotAfterCold>=2u, "%zu hot updates after cold", hotAfterCold);
+}
+
 } // namespace
 
 MAIN(testmon)
 {
-    testPlan(32);
+    testPlan(84);
     testSetup();
     logger_config_env();
     BasicTest().orphan();
@@ -344,6 +689,11 @@ MAIN(testmon)
     TestLifeCycle().testSecond();
     TestReconn().testReconn(false);
     TestReconn().testReconn(true);
+    testWorkers(false);
+    testWorkers(true);
+    testFanout();
+    testManyOps();
+    testBacklog();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -5,16 +5,24 @@
  */
 
 #include <typeinfo>
+#include <atomic>
 #include <vector>
 #include <string>
 
 #include <pvxs/sharedArray.h>
 #include <pvxs/data.h>
+#include <pvxs/client.h>
+#include <pvxs/server.h>
+#include <pvxs/sharedpv.h>
+#include <pvxs/source.h>
+#include <pvxs/nt.h>
 
 #include <pvxs/unittest.h>
 #include <epicsUnitTest.h>
 #include <testMain.h>
 
+#include "arrayops.h"
+
 namespace {
 using namespace pvxs;
 
@@ -293,11 +301,130 @@ void testConvert()
               shared_array<std::string>({"1", "2", "-1"}));
 }
 
+template<typename Src, typename Dest>
+void testConvertLongT()
+{
+    testDiag("%s<%s, %s>", __func__, typeid(Src).name(), typeid(Dest).name());
+
+    // long enough to exercise both vectorized and remainder handling
+    shared_array<Src> src(37u);
+    shared_array<Dest> expect(src.size());
+    for(size_t i=0u; i<src.size(); i++) {
+        src[i] = Src(int(i) - 18)*Src(3)/Src(2);
+        expect[i] = Dest(src[i]);
+    }
+
+    testArrEq(src.freeze().template convertTo<const Dest>(), expect.freeze());
+}
+
+void testConvertLong()
+{
+    for(auto name : {"AVX2", "SSE2", "NEON", "scalar"}) {
+        if(!impl::arrayOpsForce(name)) {
+            testSkip(4, name);
+            continue;
+        }
+        testDiag("using %s", impl::arrayOpsImpl());
+
+        testConvertLongT<int32_t, double>();
+        testConvertLongT<double, int32_t>();
+        testConvertLongT<float, double>();
+        testConvertLongT<double, float>();
+    }
+    impl::arrayOpsForce(nullptr);
+}
+
+void testStaticFilter()
+{
+    testShow()<<__func__;
+
+    auto src(server::StaticSource::build());
+    auto S(src.source());
+    auto pv(server::SharedPV::buildReadonly());
+
+    testFalse(S->mayClaim("pv:0"))<<" empty";
+
+    // enough to grow the filter several times
+    constexpr unsigned npv = 5000u;
+    for(unsigned i=0; i<npv; i++)
+        src.add("pv:"+std::to_string(i), pv);
+
+    bool allfound = true;
+    for(unsigned i=0; i<npv; i++)
+        allfound &= S->mayClaim(("pv:"+std::to_string(i)).c_str());
+    testTrue(allfound);
+
+    unsigned nfalse = 0u;
+    for(unsigned i=0; i<npv; i++)
+        nfalse += S->mayClaim(("other:"+std::to_string(i)).c_str());
+    testTrue(nfalse < npv/20u)<<" false positives "<<nfalse<<"/"<<npv;
+
+    for(unsigned i=0; i<npv; i+=2u)
+        src.remove("pv:"+std::to_string(i));
+
+    allfound = true;
+    nfalse = 0u;
+    for(unsigned i=0; i<npv; i++) {
+        bool found = S->mayClaim(("pv:"+std::to_string(i)).c_str());
+        if(i%2u)
+            allfound &= found;
+        else
+            nfalse += found;
+    }
+    testTrue(allfound);
+    testTrue(nfalse < npv/40u)<<" removed false positives "<<nfalse<<"/"<<npv/2u;
+}
+
+
+// counts onSearch() calls
+struct CountingSource : public server::Source
+{
+    const bool reject;
+    std::atomic<size_t> nsearch{0u};
+    explicit CountingSource(bool reject) :reject(reject) {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        nsearch.fetch_add(1u);
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final {}
+    virtual bool mayClaim(const char* name) const override final
+    {
+        return !reject;
+    }
+};
+
+void testRejectSearch()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto reject(std::make_shared<CountingSource>(true));
+    auto accept(std::make_shared<CountingSource>(false));
+
+    auto serv(server::Config::isolated().build()
+              .addPV("mailbox", mbox)
+              .addSource("reject", reject, 1)
+              .addSource("accept", accept, 2)
+              .start());
+    auto cli(serv.clientConfig().build());
+
+    auto val(cli.get("mailbox").exec()->wait(5.0));
+    testEq(val["value"].as<int32_t>(), 42);
+
+    testTrue(accept->nsearch.load()>0u)<<" searched "<<accept->nsearch.load();
+    testEq(reject->nsearch.load(), 0u)<<" not searched when mayClaim() rejects every name";
+}
+
 } // namespace
 
 MAIN(testshared)
 {
-    testPlan(127);
+    testPlan(151);
     testSetup();
     testEmpty<void>();
     testEmpty<const void>();
@@ -317,5 +444,9 @@ MAIN(testshared)
     testFromVector();
     testElemAlloc();
     testConvert();
+    testConvertLong();
+    testStaticFilter();
+    testRejectSearch();
+    cleanup_for_valgrind();
     return testDone();
 }
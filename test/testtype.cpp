@@ -12,6 +12,7 @@
 #include <pvxs/data.h>
 #include "utilpvt.h"
 #include "dataimpl.h"
+#include "pvaproto.h"
 
 using namespace pvxs;
 namespace  {
@@ -410,6 +411,71 @@ Value neckBolt()
                    }).create();
 }
 
+void testIntern()
+{
+    testDiag("%s()", __func__);
+    using namespace members;
+
+    const auto before = impl::internedCount();
+    {
+        auto def = [](const char* id) {
+            return TypeDef(TypeCode::Struct, id, {
+                               Int32("value"),
+                               Struct("alarm", {
+                                   Int32("severity"),
+                               }),
+                               Union("choice", {
+                                   String("text"),
+                                   Float64("number"),
+                               }),
+                               StructA("table", "row_t", {
+                                   Int32("x"),
+                               }),
+                           });
+        };
+
+        auto A(def("simple_t").create());
+        auto B(def("simple_t").create());
+        auto C(def("other_t").create());
+
+        // two, plus the shared column-wise type of "table"
+        testEq(impl::internedCount(), before+3u);
+        testOk1(Value::Helper::desc(A)==Value::Helper::desc(B));
+        testOk1(Value::Helper::desc(A)!=Value::Helper::desc(C));
+        testOk1(A.equalType(B));
+        testOk1(A.equalType(C)); // equalType() ignores ID
+
+        // a received type is shared with an identical local one
+        std::vector<uint8_t> wire;
+        {
+            VectorOutBuf buf(true, wire);
+            to_wire(buf, Value::Helper::desc(A));
+            wire.resize(wire.size()-buf.size());
+        }
+        Value D;
+        {
+            impl::TypeStore cache;
+            FixedBuf buf(true, wire);
+            impl::from_wire_type(buf, cache, D);
+            testOk1(buf.good());
+        }
+        testOk1(Value::Helper::desc(A)==Value::Helper::desc(D));
+
+        // TypeDef from Value and appending also intern
+        testOk1(Value::Helper::desc(TypeDef(A).create())==Value::Helper::desc(A));
+        auto E(TypeDef(A).create());
+        testOk1(Value::Helper::desc(E)==Value::Helper::desc(A));
+
+        {
+            TypeDef F(A);
+            F += {Int32("extra")};
+            testOk1(Value::Helper::desc(F.create())!=Value::Helper::desc(A));
+        }
+    }
+    // released along with last reference
+    testEq(impl::internedCount(), before);
+}
+
 void testOp()
 {
     testDiag("%s()", __func__);
@@ -520,7 +586,7 @@ void testFormat()
 
 MAIN(testtype)
 {
-    testPlan(51);
+    testPlan(62);
     testSetup();
     showSize();
     testCode();
@@ -528,6 +594,7 @@ MAIN(testtype)
     testTypeDef();
     testTypeDefDynamic();
     testTypeDefAppend();
+    testIntern();
     testOp();
     testFormat();
     cleanup_for_valgrind();
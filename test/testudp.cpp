@@ -17,6 +17,7 @@
 
 #include <pvxs/log.h>
 #include "evhelper.h"
+#include "utilpvt.h"
 #include <udp_collector.h>
 
 namespace {
@@ -146,12 +147,58 @@ void testSearch(bool be, std::initializer_list<const char*> names)
     testOk1(!!rx.wait(30.0));
 }
 
+void testBatch()
+{
+    testDiag("In %s native=%c", __func__, UDPRxBatch::native() ? 'Y' : 'N');
+
+    SockAddr rxaddr(SockAddr::loopback(AF_INET));
+    evsocket rxsock(AF_INET, SOCK_DGRAM, 0);
+    rxsock.bind(rxaddr);
+
+    SockAddr txaddr(SockAddr::loopback(AF_INET));
+    evsocket txsock(AF_INET, SOCK_DGRAM, 0);
+    txsock.bind(txaddr);
+
+    UDPTxBatch tx;
+    for(unsigned i=0; i<5u; i++) {
+        uint8_t msg[3] = {uint8_t(i), uint8_t(i+1u), uint8_t(i+2u)};
+        tx.push(msg, 1u+i%3u, rxaddr);
+    }
+    testEq(tx.size(), 5u);
+    tx.send(txsock.sock);
+
+    bool sentok = true;
+    for(unsigned i=0; i<tx.size(); i++) {
+        sentok &= tx[i].ntx==int(1u+i%3u);
+    }
+    testTrue(sentok);
+
+    UDPRxBatch rx(4u, 16u);
+    uint32_t ndrop = 0u;
+
+    testEq(rx.recv(rxsock.sock, &ndrop), 4);
+    for(unsigned i=0; i<4u; i++) {
+        testTrue(rx[i].len==1u+i%3u && rx[i].buf[0]==i && rx[i].src==txaddr)
+                <<" "<<i<<" len="<<rx[i].len<<" src="<<rx[i].src;
+    }
+
+    testEq(rx.recv(rxsock.sock, &ndrop), 1);
+    testTrue(rx[0].len==2u && rx[0].buf[0]==4u && rx[0].buf[1]==5u);
+
+    // nothing left
+    testEq(rx.recv(rxsock.sock, &ndrop), -1);
+    testEq(ndrop, 0u);
+
+    tx.clear();
+    testEq(tx.size(), 0u);
+}
+
 } // namespace
 
 int main(int argc, char *argv[])
 {
     SockAttach attach;
-    testPlan(46);
+    testPlan(58);
     testSetup();
     pvxs::logger_config_env();
     testBeacon(true);
@@ -160,6 +207,7 @@ int main(int argc, char *argv[])
     testSearch(false, {"hello"});
     testSearch(true , {"one", "two"});
     testSearch(false, {"one", "two"});
+    testBatch();
     cleanup_for_valgrind();
     return testDone();
 }
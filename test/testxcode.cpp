@@ -6,6 +6,7 @@
 
 #include <epicsUnitTest.h>
 #include <testMain.h>
+#include <dbDefs.h>
 
 #include <string>
 
@@ -13,7 +14,9 @@
 #include <pvxs/unittest.h>
 #include <pvxs/nt.h>
 #include "dataimpl.h"
+#include "evhelper.h"
 #include "pvaproto.h"
+#include "arrayops.h"
 
 namespace {
 using namespace pvxs;
@@ -585,6 +588,148 @@ void testArrayXCode()
     testArrayXCodeT<std::string>("\x01\x02\x02\x05hello\x05world", {"hello", "world"});
 }
 
+void testSwapCopy()
+{
+    testDiag("%s() default %s", __func__, arrayOpsImpl());
+
+    // long enough to exercise both vectorized and remainder handling
+    std::vector<uint8_t> src(8u*37u + 1u);
+    for(auto i : range(src.size()))
+        src[i] = uint8_t(i);
+
+    for(auto name : {"AVX2", "SSE2", "NEON", "scalar"}) {
+        if(!arrayOpsForce(name)) {
+            testSkip(4, name);
+            continue;
+        }
+        testDiag("using %s", arrayOpsImpl());
+
+        for(size_t esize : {1u, 2u, 4u, 8u}) {
+            bool ok = true;
+            for(size_t count=0u; count<=37u; count++) {
+                // unaligned source
+                std::vector<uint8_t> dest(count*esize);
+                swapCopy(dest.data(), src.data()+1u, count, esize);
+
+                for(size_t i=0u; i<count*esize; i++) {
+                    auto expect = src[1u + (i/esize)*esize + esize-1u-(i%esize)];
+                    if(dest[i]!=expect) {
+                        testDiag("esize=%u count=%u [%u] %02x != %02x", unsigned(esize), unsigned(count),
+                                 unsigned(i), dest[i], expect);
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+            testTrue(ok)<<" "<<name<<" esize="<<esize;
+        }
+    }
+    arrayOpsForce(nullptr);
+}
+
+void testArrayRef(bool be)
+{
+    testDiag("%s(%c)", __func__, be ? 'B' : 'L');
+
+    shared_array<uint32_t> arr(4096u);
+    for(auto i : range(arr.size()))
+        arr[i] = i;
+    auto varr(arr.freeze().castTo<const void>());
+
+    auto ebuf = evbuffer_new();
+    {
+        EvOutBuf buf(be, ebuf);
+        to_wire<uint32_t>(buf, varr);
+        testOk1(buf.good());
+    }
+
+    // in native byte order, large arrays are referenced instead of copied
+    testEq(varr.unique(), be!=hostBE);
+
+    std::vector<uint8_t> bytes(evbuffer_get_length(ebuf));
+    testEq(evbuffer_remove(ebuf, bytes.data(), bytes.size()), int(bytes.size()));
+    evbuffer_free(ebuf);
+
+    testOk1(varr.unique());
+
+    shared_array<const void> varr2;
+    {
+        FixedBuf buf(be, bytes);
+        from_wire<uint32_t>(buf, varr2);
+        testOk1(buf.good() && buf.empty());
+    }
+    testArrEq(varr.castTo<const uint32_t>(), varr2.castTo<const uint32_t>());
+
+    // prefix so that array data is aligned, assuming that an evbuffer segment is
+    bytes.insert(bytes.begin(), 3u, 0u);
+
+    ebuf = evbuffer_new();
+    testEq(evbuffer_add(ebuf, bytes.data(), bytes.size()), 0);
+    auto start = evbuffer_pullup(ebuf, -1);
+    shared_array<const void> varr3;
+    {
+        EvInBuf buf(be, ebuf);
+        uint8_t pad[3];
+        for(auto& p : pad)
+            from_wire(buf, p);
+        from_wire<uint32_t>(buf, varr3);
+        testOk1(buf.good());
+    }
+    testEq(evbuffer_get_length(ebuf), 0u);
+    evbuffer_free(ebuf);
+
+    // in native byte order, received arrays in one segment are referenced instead of copied
+    bool aliased = varr3.data()==start+8u;
+    testEq(aliased, be==hostBE && size_t(start+8u)%alignof(uint32_t)==0u);
+    testArrEq(varr.castTo<const uint32_t>(), varr3.castTo<const uint32_t>());
+}
+
+void testSegCollect()
+{
+    testDiag("%s", __func__);
+
+    shared_array<uint32_t> arr(100000u);
+    for(auto i : range(arr.size()))
+        arr[i] = i;
+    auto varr(arr.freeze().castTo<const void>());
+
+    std::vector<uint8_t> bytes;
+    {
+        VectorOutBuf buf(true, bytes);
+        to_wire<uint32_t>(buf, varr);
+        testOk1(buf.good());
+        bytes.resize(buf.consumed());
+    }
+
+    evbuf rx(evbuffer_new()), body(evbuffer_new());
+    SegCollector collect;
+
+    // deliver in small segments, each received into a separate chain
+    const size_t seglen = 1000u;
+    size_t nseg = 0u;
+    for(size_t pos = 0u; pos < bytes.size(); pos += seglen, nseg++) {
+        auto n = std::min(seglen, bytes.size()-pos);
+        (void)evbuffer_expand(rx.get(), n);
+        evbuffer_add(rx.get(), bytes.data()+pos, n);
+        collect.append(body.get(), rx.get(), n);
+    }
+    collect.reset();
+
+    testEq(evbuffer_get_length(rx.get()), 0u);
+    testEq(evbuffer_get_length(body.get()), bytes.size());
+    auto nchain = evbuffer_peek(body.get(), -1, nullptr, nullptr, 0);
+    testTrue(nchain>0 && nchain<5)<<" "<<nchain<<" chains for "<<nseg<<" segments";
+
+    shared_array<const void> varr2;
+    {
+        EvInBuf buf(true, body.get());
+        from_wire<uint32_t>(buf, varr2);
+        testOk1(buf.good());
+    }
+    testEq(evbuffer_get_length(body.get()), 0u);
+    testArrEq(varr.castTo<const uint32_t>(), varr2.castTo<const uint32_t>());
+}
+
 /*  epics:nt/NTScalarArray:1.0
  *      double[] value
  *      alarm_t alarm
@@ -1099,11 +1244,58 @@ void testEmptyRequest()
            "[0] struct  parent=[0]  [0:1)\n")<<"\nActual descs2\n"<<descs2.data();
 }
 
+void testTypeCache()
+{
+    testDiag("%s", __func__);
+
+    auto A(Value::Helper::type(nt::NTScalar{TypeCode::Float64}.create()));
+    auto B(Value::Helper::type(nt::NTScalar{TypeCode::Int32}.create()));
+    auto C(Value::Helper::type(nt::NTScalar{TypeCode::String}.create()));
+
+    // with two cache keys, C replaces A, then A replaces B, ...
+    const std::shared_ptr<const FieldDesc> seq[] = {A, A, B, A, C, A, B};
+    const bool full[] =                            {1, 0, 1, 0, 1, 1, 1};
+
+    TypeCache cache(2u);
+    TypeStore registry;
+    size_t nplain = 0u, ncached = 0u;
+
+    for(size_t i=0u; i<NELEMENTS(seq); i++) {
+        std::vector<uint8_t> plain, cached;
+        {
+            VectorOutBuf S(true, plain);
+            to_wire(S, seq[i].get());
+            plain.resize(plain.size()-S.size());
+        }
+        {
+            VectorOutBuf S(true, cached);
+            to_wire(S, seq[i], cache);
+            cached.resize(cached.size()-S.size());
+        }
+        nplain += plain.size();
+        ncached += cached.size();
+
+        if(full[i])
+            testEq(cached.size(), plain.size()+3u)<<" #"<<i<<" sends full description";
+        else
+            testEq(cached.size(), 3u)<<" #"<<i<<" sends reference";
+
+        Value val;
+        FixedBuf R(true, cached);
+        from_wire_type(R, registry, val);
+        testOk(R.good() && R.empty() && Value::Helper::desc(val)==seq[i].get(),
+               "#%u decodes to same type", unsigned(i));
+    }
+
+    testOk(ncached < nplain, "cached %u bytes < plain %u bytes", unsigned(ncached), unsigned(nplain));
+    testEq(cache.index.size(), 2u);
+}
+
 } // namespace
 
 MAIN(testxcode)
 {
-    testPlan(132);
+    testPlan(193);
     testSetup();
     testDeserializeString();
     testSerialize1();
@@ -1114,10 +1306,15 @@ MAIN(testxcode)
     testDeserialize3();
     testDecode1();
     testArrayXCode();
+    testSwapCopy();
+    testArrayRef(true);
+    testArrayRef(false);
+    testSegCollect();
     testXCodeNTScalar();
     testXCodeNTNDArray();
     testRegressRedundantBitMask();
     testBadFieldName();
     testEmptyRequest();
+    testTypeCache();
     return testDone();
 }